@@ -7,8 +7,11 @@ import <string>;
 import <vector>;
 import <random>;
 
+import audio.handle;
 import audio.sound;
 import controller;
+import controller.async;
+import core.clock;
 import core.input_event;
 import core.position;
 import engine;
@@ -17,6 +20,8 @@ import entity.animation;
 import events.event;
 import events.manager;
 import render.shape;
+import resources.manager;
+import resources.pack;
 
 import view;
 import world;
@@ -30,20 +35,84 @@ enum class FlappyAction {
 
 class FlappyBirdGame {
 public:
-    void run() {
-        // Create MVC components
-        CursesView view;
-        CursesController controller;
+    SessionResult run(const SessionOptions& options) {
+        // Create MVC components (headless runs have no terminal at all)
         Engine engine;
-        engine.addView(&view);
-        engine.setController(&controller);
+        engine.startSession(options);
+        assetShapes_ = &engine.resources();
+
+        std::unique_ptr<CursesView> view;
+        std::unique_ptr<Controller> controller;
+        if (!engine.isHeadless()) {
+            view = std::make_unique<CursesView>();
+            engine.addView(view.get());
+        }
+        if (!options.replayPath.empty()) {
+            // Engine feeds the replay log itself
+        } else if (engine.isHeadless()) {
+            // Bots and fuzzers supply their own input; none means idle input
+            if (options.controller) engine.setController(options.controller);
+        } else {
+            // --async-input reads keys on a thread and measures their latency
+            if (options.asyncInput) {
+                controller = std::make_unique<AsyncController>();
+            } else {
+                controller = std::make_unique<CursesController>();
+            }
+            engine.setController(controller.get());
+        }
 
-        // Setup SDL sound system
-        auto sdlSound = std::make_unique<SDLSoundSystem>();
-        sdlSound->loadSound("flap", "assets/sounds/flappy_bird/flap.wav");
-        sdlSound->loadSound("score", "assets/sounds/flappy_bird/score.wav");
-        sdlSound->loadSound("die", "assets/sounds/flappy_bird/die.wav");
-        engine.setSoundSystem(std::move(sdlSound));
+        // Setup SDL sound system (headless runs mix offline instead, or stay
+        // silent when nothing will be written so farm instances skip decoding)
+        CaptureSoundSystem* capture = nullptr;
+        if (engine.isHeadless() && options.audioCapturePath.empty()) {
+            engine.setSoundSystem(createSoundSystem(SoundBackend::Null));
+        } else if (engine.isHeadless()) {
+            auto captureSound = std::make_unique<CaptureSoundSystem>(44100, engine.simulationRate());
+            captureSound->loadSound("flap", "assets/sounds/flappy_bird/flap.wav");
+            captureSound->loadSound("score", "assets/sounds/flappy_bird/score.wav");
+            captureSound->loadSound("die", "assets/sounds/flappy_bird/die.wav");
+            capture = captureSound.get();
+            engine.setSoundSystem(std::move(captureSound));
+        } else {
+            // Hot reload reads the WAV files directly so edits show up immediately;
+            // otherwise prefer the memory-mapped asset pack (make pack; its shapes
+            // replace the built-in sprites), falling back to
+            // WAV files decoded in the background so the first frame isn't delayed
+            auto sdlSound = std::make_unique<SDLSoundSystem>();
+            if (options.hotReload) {
+                sdlSound->loadSoundDirectory("assets/sounds/flappy_bird");
+                sdlSound->enableHotReload(engine.assetWatcher());
+            } else {
+                const AssetPack* pack = engine.resources().loadPack("assets/assets.pack");
+                if (!pack || sdlSound->loadSounds(*pack, "flappy_bird_") == 0) {
+                    sdlSound->loadSoundAsync("flap", "assets/sounds/flappy_bird/flap.wav");
+                    sdlSound->loadSoundAsync("score", "assets/sounds/flappy_bird/score.wav");
+                    sdlSound->loadSoundAsync("die", "assets/sounds/flappy_bird/die.wav");
+                }
+            }
+            engine.setSoundSystem(std::move(sdlSound));
+        }
+
+        // Resolve sound ids once; events then carry only a handle
+        flapSound_ = engine.sound().findSound("flap");
+        scoreSound_ = engine.sound().findSound("score");
+        dieSound_ = engine.sound().findSound("die");
+
+        // Horizontal scrolling shows any frame jitter, so pace precisely
+        // (headless runs never sleep, so skip the calibration spin)
+        if (!engine.isHeadless()) {
+            engine.clock().setPacingMode(Clock::PacingMode::Precise);
+            engine.clock().calibrate();
+        }
+
+        // --hot-reload draws the bird from assets/shapes/flappy_bird/*.txt
+        // (id = file name) so edits show up live; missing files keep the
+        // built-in shape
+        if (options.hotReload) {
+            engine.resources().loadShapeDirectory("assets/shapes/flappy_bird");
+            engine.resources().enableHotReload(engine.assetWatcher());
+        }
 
         // Configure world
         World& world = engine.world();
@@ -51,10 +120,14 @@ public:
 
         // Setup game
         setupEventHandlers(engine, world);
+
+        // A snapshot restore (engine.restoreSnapshot(snap, gameShape)) rebuilds
+        // every entity; relink the bird
+        engine.setOnSnapshotRestored([this, &world] { bird_ = world.player(); });
         createBird(engine, world);
 
         // Register per-tick logic
-        engine.setGameUpdate([this, &engine, &world](float dt, const InputEvent& input) {
+        engine.setGameUpdate([this, &engine, &world](float dt, const InputState& input) {
             // Handle player input
             FlappyAction action = translateInput(input);
             if (action == FlappyAction::Flap) {
@@ -67,9 +140,23 @@ public:
         });
 
         engine.run();
+
+        if (capture && !options.audioCapturePath.empty()) {
+            capture->writeWav(options.audioCapturePath);
+        }
+
+        SessionResult result = engine.sessionResult();
+        result.score = score_;
+        result.gameOver = gameOver_;
+        return result;
     }
 
 private:
+    // Sound handles (resolved once after loading)
+    SoundHandle flapSound_;
+    SoundHandle scoreSound_;
+    SoundHandle dieSound_;
+
     // Game state
     std::shared_ptr<Entity> bird_{nullptr};
 
@@ -83,6 +170,25 @@ private:
     Shape birdFlapShape_{"bird_flap", {/* shape definition */}};
     std::vector<std::unique_ptr<Shape>> pipeShapes_;
 
+    // Shapes loaded from the asset pack or (--hot-reload) shape files
+    const ResourceManager* assetShapes_{nullptr};
+
+    // The loaded copy of a built-in sprite when there is one (same id)
+    const Shape* sprite(const Shape& builtIn) const {
+        const Shape* loaded = assetShapes_ ? assetShapes_->getShape(builtIn.spriteId()) : nullptr;
+        return loaded ? loaded : &builtIn;
+    }
+
+    // Game-owned shapes by sprite id (snapshot restore)
+    const Shape* gameShape(const std::string& id) const {
+        if (id == birdShape_.spriteId()) return &birdShape_;
+        if (id == birdFlapShape_.spriteId()) return &birdFlapShape_;
+        for (const auto& pipe : pipeShapes_) {
+            if (pipe->spriteId() == id) return pipe.get();
+        }
+        return nullptr;
+    }
+
     // Example: Setting up event handlers
     void setupEventHandlers(Engine& engine, World& world) {
         // Subscribe to collision events
@@ -102,14 +208,14 @@ private:
     // Example: Creating entities with movement and animations
     void createBird(Engine& engine, World& world) {
         // Create bird entity
-        bird_ = world.createEntity(nextEntityId_++, "bird", Position{BIRD_X, 10}, &birdShape_);
+        bird_ = world.createEntity(nextEntityId_++, "bird", Position{BIRD_X, 10}, sprite(birdShape_));
         bird_->addMovement(std::make_unique<GravityMovement>(FALL_SPEED));
         bird_->setSolidity(Solidity::Solid);
 
         // Set bird animation
         std::vector<Frame> frames;
-        frames.push_back({&birdShape_, 25});
-        frames.push_back({&birdFlapShape_, 15});
+        frames.push_back({sprite(birdShape_), 25});
+        frames.push_back({sprite(birdFlapShape_), 15});
         bird_->setAnimation(std::make_unique<Animation>(std::move(frames), true));
 
         // Set collision callback
@@ -147,19 +253,18 @@ private:
     }
 
     // Example: Input translation
-    FlappyAction translateInput(const InputEvent& input) const {
-        const KeyboardInput* kb = getKeyboardInput(input);
-        if (!kb) return FlappyAction::None;
-
-        switch (kb->key) {
-            case ' ':
-            case 'w':
-            case 'W':
-            case KEY_UP:
+    FlappyAction translateInput(const InputState& input) const {
+        // Every key-down event flaps, however fast the taps come (pressed()
+        // would swallow re-taps while the key still counts as held)
+        for (const InputEvent& event : input.events()) {
+            const KeyboardInput* keyboard = getKeyboardInput(event);
+            if (!keyboard) continue;
+            int key = keyboard->key;
+            if (key == ' ' || key == 'w' || key == 'W' || key == KEY_UP) {
                 return FlappyAction::Flap;
-            default:
-                return FlappyAction::None;
+            }
         }
+        return FlappyAction::None;
     }
 
     // Example: Handling game actions
@@ -167,7 +272,7 @@ private:
         if (!bird_ || !bird_->isAlive() || gameOver_) return;
 
         bird_->move(0, -FLAP_HEIGHT);
-        engine.events().emit<SoundEvent>("flap");
+        engine.events().emit<SoundEvent>(flapSound_);
     }
 
     void triggerGameOver(Engine& engine, World& world) {
@@ -175,7 +280,7 @@ private:
         
         gameOver_ = true;
 
-        engine.events().emit<SoundEvent>("die");
+        engine.events().emit<SoundEvent>(dieSound_);
         engine.events().emit<GameOverEvent>(false);
 
         updateStatusLines(world);
@@ -196,8 +301,8 @@ private:
     }
 };
 
-    void runFlappyBird() {
+    SessionResult runFlappyBird(const SessionOptions& options) {
         FlappyBirdGame game;
-        game.run();
+        return game.run(options);
     }
 }
\ No newline at end of file
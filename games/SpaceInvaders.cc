@@ -2,13 +2,19 @@
 
 #include <ncurses.h>
 
+import <array>;
 import <memory>;
 import <string>;
 import <vector>;
+import <utility>;
 import <random>;
 
+import audio.handle;
 import audio.sound;
+import audio.voices;
+import behavior;
 import controller;
+import controller.async;
 import core.input_event;
 import core.position;
 import engine;
@@ -16,13 +22,21 @@ import entity;
 import entity.animation;
 import events.event;
 import events.manager;
+import particles;
 import render.shape;
+import render.tilemap;
+import resources.manager;
+import resources.pack;
+import resources.prefab;
 
 import view;
 import world;
 
 namespace age {
 
+// Enemy fire rate for file levels without "set shootInterval"
+constexpr int DEFAULT_ENEMY_SHOOT_INTERVAL = 60;
+
 enum class SpaceAction {
     None,
     MoveUp,
@@ -32,21 +46,112 @@ enum class SpaceAction {
 
 class SpaceInvadersGame {
 public:
-    void run() {
-        // Create MVC components
-        CursesView view;
-        CursesController controller;
+    SessionResult run(const SessionOptions& options) {
+        // Create MVC components (headless runs have no terminal at all)
         Engine engine;
-        engine.addView(&view);
-        engine.setController(&controller);
+        engine.startSession(options);
+        assetShapes_ = &engine.resources();
+
+        std::unique_ptr<CursesView> view;
+        std::unique_ptr<Controller> controller;
+        if (!engine.isHeadless()) {
+            view = std::make_unique<CursesView>();
+            engine.addView(view.get());
+        }
+        if (!options.replayPath.empty()) {
+            // Engine feeds the replay log itself
+        } else if (engine.isHeadless()) {
+            // Bots and fuzzers supply their own input; none means idle input
+            if (options.controller) engine.setController(options.controller);
+        } else {
+            // --async-input reads keys on a thread and measures their latency
+            if (options.asyncInput) {
+                controller = std::make_unique<AsyncController>();
+            } else {
+                controller = std::make_unique<CursesController>();
+            }
+            engine.setController(controller.get());
+        }
 
-        // Setup SDL sound system
-        auto sdlSound = std::make_unique<SDLSoundSystem>();
-        sdlSound->loadSound("shoot", "assets/sounds/space_invaders/shoot.wav");
-        sdlSound->loadSound("hit", "assets/sounds/space_invaders/hit.wav");
-        sdlSound->loadSound("die", "assets/sounds/space_invaders/die.wav");
-        sdlSound->loadSound("win", "assets/sounds/space_invaders/win.wav");
-        engine.setSoundSystem(std::move(sdlSound));
+        // Setup SDL sound system (headless runs mix offline instead, or stay
+        // silent when nothing will be written so farm instances skip decoding)
+        CaptureSoundSystem* capture = nullptr;
+        if (engine.isHeadless() && options.audioCapturePath.empty()) {
+            engine.setSoundSystem(createSoundSystem(SoundBackend::Null));
+        } else if (engine.isHeadless()) {
+            auto captureSound = std::make_unique<CaptureSoundSystem>(44100, engine.simulationRate());
+            captureSound->loadSound("shoot", "assets/sounds/space_invaders/shoot.wav");
+            captureSound->loadSound("hit", "assets/sounds/space_invaders/hit.wav");
+            captureSound->loadSound("die", "assets/sounds/space_invaders/die.wav");
+            captureSound->loadSound("win", "assets/sounds/space_invaders/win.wav");
+            capture = captureSound.get();
+            engine.setSoundSystem(std::move(captureSound));
+        } else {
+            // Hot reload reads the WAV files directly so edits show up immediately;
+            // otherwise prefer the memory-mapped asset pack (make pack; its shapes
+            // replace the built-in sprites), falling back to
+            // WAV files decoded in the background so the first frame isn't delayed
+            auto sdlSound = std::make_unique<SDLSoundSystem>();
+            if (options.hotReload) {
+                sdlSound->loadSoundDirectory("assets/sounds/space_invaders");
+                sdlSound->enableHotReload(engine.assetWatcher());
+            } else {
+                const AssetPack* pack = engine.resources().loadPack("assets/assets.pack");
+                if (!pack || sdlSound->loadSounds(*pack, "space_invaders_") == 0) {
+                    sdlSound->loadSoundAsync("shoot", "assets/sounds/space_invaders/shoot.wav");
+                    sdlSound->loadSoundAsync("hit", "assets/sounds/space_invaders/hit.wav");
+                    sdlSound->loadSoundAsync("die", "assets/sounds/space_invaders/die.wav");
+                    sdlSound->loadSoundAsync("win", "assets/sounds/space_invaders/win.wav");
+                }
+            }
+
+            // A wave of kills fires many hits per tick; cap them and let the
+            // important sounds steal voices if needed (skipping any sound
+            // whose asset is missing, e.g. there is no win.wav yet)
+            const std::pair<const char*, SoundPolicy> policies[] = {
+                {"hit", SoundPolicy{3, 40, 0}},
+                {"die", SoundPolicy{1, 0, 10}},
+                {"win", SoundPolicy{1, 0, 10}},
+            };
+            for (const auto& [id, policy] : policies) {
+                SoundHandle handle = sdlSound->findSound(id);
+                if (handle.valid()) sdlSound->setSoundPolicy(handle, policy);
+            }
+            engine.setSoundSystem(std::move(sdlSound));
+        }
+
+        // Resolve sound ids once; events then carry only a handle
+        shootSound_ = engine.sound().findSound("shoot");
+        hitSound_ = engine.sound().findSound("hit");
+        dieSound_ = engine.sound().findSound("die");
+        winSound_ = engine.sound().findSound("win");
+
+        // --hot-reload draws sprites from assets/shapes/space_invaders/*.txt
+        // (id = file name) so edits show up live; missing files keep the
+        // built-in shape. Loaded before the level file, whose prefabs look
+        // shapes up in the ResourceManager first.
+        if (options.hotReload) {
+            engine.resources().loadShapeDirectory("assets/shapes/space_invaders");
+            engine.resources().enableHotReload(engine.assetWatcher());
+        }
+
+        // Every enemy plays the same clip; register it once and share it
+        enemyClip_ = engine.resources().registerClip("enemy_idle",
+            {{sprite(enemyShapeA_), ANIM_INTERVAL_TICKS}, {sprite(enemyShapeB_), ANIM_INTERVAL_TICKS}});
+
+        // Tile palettes hold ResourceManager shapes; the stars twinkle by
+        // swapping their palette entry between the two frames
+        starFrames_ = {resourceShape(engine.resources(), starShapeA_),
+                       resourceShape(engine.resources(), starShapeB_)};
+
+        // Levels (layouts, fire rate, how many there are) and the enemy
+        // bullet come from a level file when present (edit it without
+        // recompiling); otherwise the built-in LEVELS grids are used
+        if (engine.resources().loadPrefabFile("assets/levels/space_invaders.txt",
+                [this](const std::string& id) { return gameShape(id); })) {
+            levels_ = engine.resources().levels();
+            enemyBulletPrefab_ = engine.resources().getPrefab("enemy_bullet");
+        }
 
         // Configure world
         World& world = engine.world();
@@ -54,16 +159,25 @@ public:
 
         // Setup game
         setupEventHandlers(engine, world);
-        setupLevel(world, 1);
+
+        // A snapshot restore (engine.restoreSnapshot(snap, gameShape)) rebuilds
+        // every entity; relink the pointers this game keeps
+        engine.setOnSnapshotRestored([this, &world] {
+            player_ = world.player();
+            enemiesRemaining_ = static_cast<int>(world.findEntitiesByTag("enemy").size());
+        });
+        setupLevel(engine, world, 1);
+
+        // Enemy fire sleeps between volleys instead of counting down every tick
+        engine.behaviors().spawn(enemyFire(engine.behaviors(), engine, world));
 
         // Register per-tick logic
-        engine.setGameUpdate([this, &engine, &world](float dt, const InputEvent& input) {
-            // Handle player input
-            SpaceAction action = translateInput(input);
-            handleAction(action, engine, world);
+        engine.setGameUpdate([this, &engine, &world](float dt, const InputState& input) {
+            // Handle player input (movement and shooting can combine in one tick)
+            applyInput(input, engine, world);
 
             updateEnemyMovement(world);
-            updateEnemyShooting(world);
+            animateStars();
 
             // Check for level completion
             checkLevelComplete(engine, world);
@@ -75,9 +189,26 @@ public:
         });
 
         engine.run();
+
+        if (capture && !options.audioCapturePath.empty()) {
+            capture->writeWav(options.audioCapturePath);
+        }
+
+        SessionResult result = engine.sessionResult();
+        result.score = score_;
+        result.level = level_;
+        result.won = victory_;
+        result.gameOver = gameOver_ || victory_;
+        return result;
     }
 
 private:
+    // Sound handles (resolved once after loading)
+    SoundHandle shootSound_;
+    SoundHandle hitSound_;
+    SoundHandle dieSound_;
+    SoundHandle winSound_;
+
     // Game state
     std::shared_ptr<Entity> player_{nullptr};
 
@@ -94,7 +225,14 @@ private:
     // Enemy movement state
     float enemyMoveAccumulator_{0.0f};
     int enemyDirection_{1};  // 1 = down, -1 = up
-    int enemyShootTimer_{60};
+
+    // Shared enemy animation (registered in the ResourceManager)
+    ClipId enemyClip_{InvalidClip};
+
+    // Compiled levels from the level file (empty = use LEVELS)
+    std::vector<const Level*> levels_;
+    const Prefab* enemyBulletPrefab_{nullptr};
+    std::vector<Entity*> shooters_; // reused by fireEnemyBullet()
 
     // Shapes (actual shapes would be defined here)
     Shape playerShapeA_{"player_a", {/* shape definition */}};
@@ -106,6 +244,30 @@ private:
     Shape starShapeA_{"star_a", {/* shape definition */}};
     Shape starShapeB_{"star_b", {/* shape definition */}};
 
+    // Star field: one palette entry on the tile layer, two frames
+    std::array<const Shape*, 2> starFrames_{};
+    TileMap* starLayer_{nullptr};
+    TileIndex starTile_{EmptyTile};
+    int starFrame_{0};
+    int starTicks_{0};
+
+    // ResourceManager copy of a built-in shape (an already loaded one wins)
+    static const Shape* resourceShape(ResourceManager& resources, const Shape& shape) {
+        if (const Shape* loaded = resources.getShape(shape.spriteId())) return loaded;
+        std::vector<std::string> rows;
+        for (int r = 0; r < shape.height(); ++r) rows.emplace_back(shape.row(r));
+        return resources.registerShape(shape.spriteId(), std::move(rows));
+    }
+
+    // Shapes loaded from the asset pack or (--hot-reload) shape files
+    const ResourceManager* assetShapes_{nullptr};
+
+    // The loaded copy of a built-in sprite when there is one (same id)
+    const Shape* sprite(const Shape& builtIn) const {
+        const Shape* loaded = assetShapes_ ? assetShapes_->getShape(builtIn.spriteId()) : nullptr;
+        return loaded ? loaded : &builtIn;
+    }
+
     // Example: Setting up event handlers
     void setupEventHandlers(Engine& engine, World& world) {
         // Subscribe to collision events
@@ -118,7 +280,7 @@ private:
         });
     }
 
-    void setupLevel(World& world, int level) {
+    void setupLevel(Engine& engine, World& world, int level) {
         level_ = level;
         
         // Clear existing entities
@@ -131,30 +293,47 @@ private:
         enemyDirection_ = 1;
         shootCooldown_ = 0;
         
-        const LevelConfig& config = LEVELS[level-1];
-        enemyShootTimer_ = config.shootInterval;
-
         // Create player
         createPlayer(world);
 
         // Background decorations
-        spawnStars(world, 8);
+        spawnStars(engine, world, 8);
 
         // Create enemy grid
-        spawnEnemyGrid(world, config.enemyRows, config.enemyCols);
+        const Level* data = levelData(level);
+        if (data) {
+            world.instantiateLevel(*data, nextEntityId_);
+            enemiesRemaining_ = static_cast<int>(data->countTag("enemy"));
+        } else {
+            const LevelConfig& config = LEVELS[level - 1];
+            spawnEnemyGrid(world, config.enemyRows, config.enemyCols);
+        }
+    }
+
+    // Game-owned shapes by sprite id (level file and snapshot restore)
+    const Shape* gameShape(const std::string& id) const {
+        if (id == "player_a") return &playerShapeA_;
+        if (id == "player_b") return &playerShapeB_;
+        if (id == "enemy_a") return &enemyShapeA_;
+        if (id == "enemy_b") return &enemyShapeB_;
+        if (id == "star_a") return &starShapeA_;
+        if (id == "star_b") return &starShapeB_;
+        if (id == "enemy_bullet") return &enemyBulletShape_;
+        if (id == "bullet") return &bulletShape_;
+        return nullptr;
     }
 
     // Example: Creating entities with animations
     void createPlayer(World& world) {
         int startY = world.height()/2 - 1;
-        player_ = world.createEntity(nextEntityId_++, "player", Position{PLAYER_X, startY}, &playerShapeA_);
+        player_ = world.createEntity(nextEntityId_++, "player", Position{PLAYER_X, startY}, sprite(playerShapeA_));
         player_->setSolidity(Solidity::Solid);
         player_->setClampToBorders(true);
         world.setPlayer(player_);
 
         std::vector<Frame> frames;
-        frames.push_back({&playerShapeA_, ANIM_INTERVAL_TICKS});
-        frames.push_back({&playerShapeB_, ANIM_INTERVAL_TICKS});
+        frames.push_back({sprite(playerShapeA_), ANIM_INTERVAL_TICKS});
+        frames.push_back({sprite(playerShapeB_), ANIM_INTERVAL_TICKS});
         player_->setAnimation(std::make_unique<Animation>(std::move(frames), true));
     }
 
@@ -165,32 +344,44 @@ private:
         // Implementation details removed but would:
         // 1. Calculate grid positions
         // 2. Create enemy entities in a grid pattern
-        // 3. Set up animations for each enemy
+        // 3. enemy->setAnimation(enemyClip_, true) so the whole grid shares
+        //    one clip and flips frames in step with the world tick
+    }
+
+    // Randomness comes from engine.rng() so snapshots and replays capture it
+    void spawnStars(Engine& engine, World& world, int count) {
+        // Stars are pure scenery: place them on a tile layer instead of
+        // spawning entities that would be updated and collision-tested every tick
+        world.clearTileLayers();
+        TileMap& stars = world.createTileLayer(world.width(), world.height());
+        starLayer_ = &stars;
+        starFrame_ = 0;
+        starTile_ = stars.registerTile(starFrames_[starFrame_]);
+
+        std::uniform_int_distribution<int> xDist(0, world.width() - 1);
+        std::uniform_int_distribution<int> yDist(0, world.height() - 1);
+        for (int i = 0; i < count; ++i) {
+            stars.setTile(xDist(engine.rng()), yDist(engine.rng()), starTile_);
+        }
     }
 
-    void spawnStars(World& world, int count) {
-        // Implementation details removed but would spawn animated background star entities
+    // Every star shares one palette entry, so a frame flip is one write
+    void animateStars() {
+        if (!starLayer_ || ++starTicks_ % ANIM_INTERVAL_TICKS != 0) return;
+        starFrame_ ^= 1;
+        starLayer_->setTileShape(starTile_, starFrames_[starFrame_]);
     }
 
     // Example: Input translation
-    SpaceAction translateInput(const InputEvent& input) const {
-        const KeyboardInput* kb = getKeyboardInput(input);
-        if (!kb) return SpaceAction::None;
-
-        switch (kb->key) {
-            case 'w':
-            case 'W':
-            case KEY_UP:
-                return SpaceAction::MoveUp;
-            case 's':
-            case 'S':
-            case KEY_DOWN:
-                return SpaceAction::MoveDown;
-            case ' ':
-                return SpaceAction::Shoot;
-            default:
-                return SpaceAction::None;
-        }
+    // Applied straight from the InputState, so a tick allocates nothing
+    void applyInput(const InputState& input, Engine& engine, World& world) {
+        bool up = input.held('w') || input.held('W') || input.held(KEY_UP);
+        bool down = input.held('s') || input.held('S') || input.held(KEY_DOWN);
+
+        if (up && !down) handleAction(SpaceAction::MoveUp, engine, world);
+        if (down && !up) handleAction(SpaceAction::MoveDown, engine, world);
+        // Shooting is rate-limited by shootCooldown_, so holding space auto-fires
+        if (input.held(' ')) handleAction(SpaceAction::Shoot, engine, world);
     }
 
     // Example: Handling game actions
@@ -220,13 +411,15 @@ private:
         int bulletX = player_->position().x + 4;
         int bulletY = player_->position().y + 1;
         
-        auto bullet = world.createEntity(nextEntityId_++, "player_bullet", Position{bulletX, bulletY}, &bulletShape_);
+        auto bullet = world.createEntity(nextEntityId_++, "player_bullet", Position{bulletX, bulletY}, sprite(bulletShape_));
         bullet->addMovement(std::make_unique<StraightMovement>(BULLET_SPEED, 0.0f));
         bullet->setSolidity(Solidity::Trigger);
         bullet->setClampToBorders(false);
+        // BULLET_SPEED can exceed one cell per tick; sweep so it can't skip enemies
+        bullet->setContinuousCollision(true);
         
         shootCooldown_ = SHOOT_COOLDOWN;
-        engine.events().emit<SoundEvent>("shoot");
+        engine.events().emit<SoundEvent>(shootSound_);
     }
 
     void updateEnemyMovement(World& world) {
@@ -236,24 +429,65 @@ private:
         // 3. Move all enemies and reverse direction when hitting edges
     }
 
-    void updateEnemyShooting(World& world) {
-        // Implementation details removed but would:
-        // 1. Decrement shooting timer
-        // 2. Select random enemy to shoot
-        // 3. Spawn enemy bullet with movement component
+    // Number of levels: every level in the file, or the built-in LEVELS
+    int levelCount() const {
+        return levels_.empty() ? static_cast<int>(std::size(LEVELS)) : static_cast<int>(levels_.size());
+    }
+
+    // Compiled level for a 1-based level number (nullptr = LEVELS fallback)
+    const Level* levelData(int level) const {
+        return levels_.empty() ? nullptr : levels_[level - 1];
+    }
+
+    int enemyShootInterval() const {
+        const Level* data = levelData(level_);
+        return data ? data->property("shootInterval", DEFAULT_ENEMY_SHOOT_INTERVAL)
+                    : LEVELS[level_ - 1].shootInterval;
+    }
+
+    // Example: Coroutine behavior (resumed by the scheduler only when due)
+    Behavior enemyFire(BehaviorScheduler& scheduler, Engine& engine, World& world) {
+        while (!gameOver_ && !victory_) {
+            co_await waitTicks(enemyShootInterval());
+            // The game may have ended while this behavior slept
+            if (gameOver_ || victory_) co_return;
+            fireEnemyBullet(engine, world);
+        }
+    }
+
+    // A random live enemy fires from its left edge
+    void fireEnemyBullet(Engine& engine, World& world) {
+        shooters_.clear();
+        for (const auto& entity : world.entities()) {
+            if (entity && entity->isAlive() && entity->tag() == "enemy") shooters_.push_back(entity.get());
+        }
+        if (shooters_.empty()) return;
+
+        std::uniform_int_distribution<std::size_t> pick(0, shooters_.size() - 1);
+        const Position& from = shooters_[pick(engine.rng())]->position();
+        Position at{from.x - 1, from.y + 1};
+
+        if (enemyBulletPrefab_) {
+            world.instantiate(*enemyBulletPrefab_, nextEntityId_++, at);
+        } else {
+            auto bullet = world.createEntity(nextEntityId_++, "enemy_bullet", at, &enemyBulletShape_);
+            bullet->addMovement(std::make_unique<StraightMovement>(-1.0f, 0.0f));
+            bullet->setSolidity(Solidity::Trigger);
+            bullet->setClampToBorders(false);
+        }
     }
 
     void checkLevelComplete(Engine& engine, World& world) {
         if (enemiesRemaining_ <= 0) {
-            if (level_ < 2) {
+            if (level_ < levelCount()) {
                 // Advance to next level
                 level_++;
-                setupLevel(world, level_);
-                engine.events().emit<SoundEvent>("win");
+                setupLevel(engine, world, level_);
+                engine.events().emit<SoundEvent>(winSound_);
             } else {
                 // Victory
                 victory_ = true;
-                engine.events().emit<SoundEvent>("win");
+                engine.events().emit<SoundEvent>(winSound_);
                 engine.events().emit<GameOverEvent>(true);
             }
         }
@@ -268,7 +502,16 @@ private:
         
         gameOver_ = true;
 
-        engine.events().emit<SoundEvent>("die");
+        // Player explosion (particles, not entities)
+        if (player_) {
+            ParticleSpawn explosion;
+            explosion.x = static_cast<float>(player_->position().x + 2);
+            explosion.y = static_cast<float>(player_->position().y + 1);
+            explosion.glyphs = "@*+.";
+            engine.particles().burst(explosion, 200);
+        }
+
+        engine.events().emit<SoundEvent>(dieSound_);
         engine.events().emit<GameOverEvent>(false);
     }
 
@@ -297,8 +540,8 @@ private:
     }
 };
 
-    void runSpaceInvaders() {
+    SessionResult runSpaceInvaders(const SessionOptions& options) {
         SpaceInvadersGame game;
-        game.run();
+        return game.run(options);
     }
 }
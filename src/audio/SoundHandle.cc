@@ -0,0 +1,18 @@
+export module audio.handle;
+
+import <cstdint>;
+
+export namespace age {
+
+// Compact id of a loaded sound, returned by SoundSystem::loadSound/findSound
+// Playing by handle is an array index instead of a string hash lookup.
+struct SoundHandle {
+    static constexpr std::uint32_t Invalid = 0xFFFFFFFFu;
+
+    std::uint32_t index{Invalid};
+
+    constexpr bool valid() const noexcept { return index != Invalid; }
+    friend constexpr bool operator==(SoundHandle, SoundHandle) = default;
+};
+
+}
@@ -5,9 +5,24 @@ module;
 
 export module audio.sound;
 
+import <atomic>;
+import <cstdint>;
+import <condition_variable>;
+import <deque>;
 import <memory>;
+import <mutex>;
 import <string>;
+import <string_view>;
+import <thread>;
 import <unordered_map>;
+import <vector>;
+
+import audio.handle;
+import audio.voices;
+import core.memory;
+import core.spsc_queue;
+import resources.pack;
+import resources.watcher;
 
 export namespace age {
 
@@ -16,18 +31,40 @@ class SoundSystem {
 public:
     virtual ~SoundSystem() = default;
 
-    virtual void play(const std::string& soundId) = 0;
+    // Resolve a sound id once and keep the handle (Invalid if unknown)
+    virtual SoundHandle findSound(const std::string& soundId) const;
+
+    virtual void play(SoundHandle handle) = 0;
+    void play(const std::string& soundId); // findSound() + play(handle)
     virtual void stopAll() = 0;
 
     virtual void setMuted(bool muted) = 0;
     virtual bool isMuted() const = 0;
     void toggleMute();
+
+    // Swap in hot-reloaded sounds; called by Engine at a tick boundary
+    // Returns the number swapped (backends without hot reload return 0)
+    virtual int applyReloads();
+
+    // Called by Engine once per tick after events are processed; backends
+    // that coalesce requests flush them here (default: nothing to flush)
+    virtual void endTick();
+
+    // Voices currently playing (0 for backends without voices)
+    virtual int activeVoices() const;
+
+    // Report decoded sample memory (SDL chunks, capture buffers) to resource
+    // as it is loaded and released (default: nothing to report)
+    virtual void setMemoryTracking(TrackingResource* resource);
 };
 
 // SoundClip (RAII wrapper for Mix_Chunk*)
 class SoundClip {
 public:
     explicit SoundClip(const std::string& path);
+
+    // Zero-copy clip over packed PCM (Mix_QuickLoad_RAW); the pack must outlive it
+    explicit SoundClip(const PcmView& pcm);
     
     ~SoundClip() = default;
     
@@ -55,9 +92,48 @@ public:
     ~SDLSoundSystem() override;
     
     // Load a sound file
-    void loadSound(const std::string& id, const std::string& path);
+    SoundHandle loadSound(const std::string& id, const std::string& path);
+
+    // Load sounds straight from a mapped asset pack (no decoding or copying)
+    SoundHandle loadSound(const std::string& id, const PcmView& pcm);
+
+    // Load every packed sound whose id starts with prefix, registered without it
+    // Returns the number of sounds loaded
+    int loadSounds(const AssetPack& pack, std::string_view prefix = "");
+
+    // File-backed sounds: every .wav in directory, id = file name without extension
+    int loadSoundDirectory(const std::string& directory);
+
+    // Decode on background worker threads and return the handle immediately
+    // play() on a sound that isn't ready yet is a silent no-op, so games can
+    // show their first frame while clips are still decoding
+    SoundHandle loadSoundAsync(const std::string& id, const std::string& path);
+    bool isReady(SoundHandle handle) const;
+    int pendingLoads() const;
+    void waitForLoads();
+
+    // Watch directories passed to loadSoundDirectory() on the shared watcher
+    // (Engine::assetWatcher(); the destructor unwatches). Edited clips are
+    // decoded on the watcher thread and swapped in by applyReloads()
+    bool enableHotReload(AssetWatcher& watcher);
+    int applyReloads() override;
     
-    void play(const std::string& soundId) override;
+    using SoundSystem::play;
+    SoundHandle findSound(const std::string& soundId) const override;
+
+    // Never blocks: marks the sound as requested this tick; endTick() posts
+    // one Play command per distinct sound, so a burst of identical requests
+    // in one tick costs a single voice
+    void play(SoundHandle handle) override;
+    void endTick() override;
+
+    // Voice management (applied on the audio thread by the VoiceManager)
+    // Invalid handles are ignored
+    void setSoundPolicy(SoundHandle handle, const SoundPolicy& policy);
+    void setDefaultSoundPolicy(const SoundPolicy& policy);
+    void setPolyphony(int voices);
+    int activeVoices() const override;
+    void setMemoryTracking(TrackingResource* resource) override;
     
     void stopAll() override;
     
@@ -67,9 +143,85 @@ public:
     bool isInitialized() const;
 
 private:
+    // Request from the game thread to the audio thread
+    // Clips travel as owning raw pointers because the queue holds trivial
+    // values; the audio thread adopts them into clips_ immediately.
+    struct AudioCommand {
+        enum class Op : std::uint8_t { Play, StopAll, SetMuted, ReplaceClip, SetPolicy, SetPolyphony, Quit };
+
+        Op op;
+        SoundHandle handle;
+        bool flag;
+        int value;
+        SoundPolicy policy;
+        SoundClip* clip;
+    };
+
+    SoundHandle registerClip(const std::string& id, std::unique_ptr<SoundClip> clip);
+    void post(const AudioCommand& command);
+    void audioLoop();
+
     bool initialized_;
-    bool muted_;
-    std::unordered_map<std::string, std::unique_ptr<SoundClip>> sounds_;
+    std::atomic<bool> muted_;
+
+    // Handle -> clip. Sized to MaxSounds up front so it never reallocates.
+    // Written on the game thread only before the audio thread starts (first
+    // play); afterwards only the audio thread touches it and new, async-loaded
+    // or reloaded clips arrive as ReplaceClip commands.
+    static constexpr std::size_t MaxSounds = 256;
+    std::vector<std::unique_ptr<SoundClip>> clips_;
+    std::unordered_map<std::string, SoundHandle> handles_;
+    std::vector<std::uint8_t> ready_; // game thread view of which handles can play
+
+    // Lock-free SPSC command queue drained by a dedicated audio thread, so
+    // the simulation thread never blocks inside SDL_mixer
+    SpscQueue<AudioCommand> commands_{256};
+    std::thread audioThread_;
+    int wakeFd_{-1}; // eventfd the audio thread sleeps on between commands
+
+    // Per-tick coalescing (game thread)
+    std::vector<std::uint8_t> requestedThisTick_; // indexed by handle
+    std::vector<SoundHandle> requests_;
+
+    TrackingResource* memory_{nullptr}; // decoded chunk bytes are reported here
+
+    // Audio thread only; activeVoices_ is its published voice count
+    VoiceManager voices_;
+    std::atomic<int> activeVoices_{0};
+
+    // Hot reload: decoded off the game thread, applied by applyReloads()
+    // Keyed by id, so repeated saves of one clip coalesce to the newest decode
+    std::vector<std::string> soundDirectories_;
+    std::mutex pendingClipsMutex_;
+    std::unordered_map<std::string, std::unique_ptr<SoundClip>> pendingClips_;
+    AssetWatcher* watcher_{nullptr}; // (owned externally by Engine)
+    std::vector<int> watchIds_;
+
+    // Async loading: a small worker pool (up to hardware_concurrency, max 4)
+    // decodes WAVs in parallel; endTick() hands finished clips to the audio
+    // thread. Several producers, so these use a mutex rather than the SPSC queue.
+    struct LoadJob {
+        SoundHandle handle;
+        std::string path;
+    };
+
+    struct LoadedClip {
+        SoundHandle handle;
+        std::unique_ptr<SoundClip> clip;
+    };
+
+    void startLoaders();
+    void loaderLoop();
+    void collectLoaded();
+
+    std::vector<std::thread> loaders_;
+    mutable std::mutex loadMutex_;
+    std::condition_variable loadReady_;
+    std::condition_variable loadDone_;
+    std::deque<LoadJob> loadJobs_;
+    std::vector<LoadedClip> loadedClips_;
+    int loadsInFlight_{0};
+    bool stopLoaders_{false};
 };
 
 // Terminal implementation (uses ncurses beep() for terminal audio)
@@ -78,7 +230,10 @@ public:
     TerminalSoundSystem() = default;
     ~TerminalSoundSystem() override = default;
 
-    void play(const std::string& soundId) override;
+    using SoundSystem::play;
+    // Every id maps to the same beep
+    SoundHandle findSound(const std::string& soundId) const override;
+    void play(SoundHandle handle) override;
 
     void stopAll() override;
 
@@ -89,13 +244,97 @@ private:
     bool muted_;
 };
 
+// One sound request recorded by CaptureSoundSystem
+struct CapturedTrigger {
+    int tick;
+    SoundHandle handle;
+    bool played; // false if muted, unknown or out of voices
+};
+
+// Offline software-mixing implementation (no audio device)
+// Mixes every voice into an in-memory interleaved S16 stereo buffer and
+// advances exactly one tick of samples per endTick(), so the output depends
+// only on the sequence of requests, not on wall time. Every request is
+// logged with its tick, which lets headless runs assert audio behaviour and
+// benchmark mixing cost in CI.
+class CaptureSoundSystem final : public SoundSystem {
+public:
+    explicit CaptureSoundSystem(int sampleRate = 44100, int ticksPerSecond = 60, int maxVoices = 32);
+    ~CaptureSoundSystem() override = default;
+
+    // WAV files are decoded and converted to the capture rate at load time
+    SoundHandle loadSound(const std::string& id, const std::string& path);
+    SoundHandle loadSound(const std::string& id, const PcmView& pcm);
+
+    using SoundSystem::play;
+    SoundHandle findSound(const std::string& soundId) const override;
+    void play(SoundHandle handle) override;
+    void stopAll() override;
+
+    // Mix one tick of audio into the capture buffer
+    void endTick() override;
+
+    void setMuted(bool muted) override;
+    bool isMuted() const override;
+    int activeVoices() const override;
+    void setMemoryTracking(TrackingResource* resource) override;
+
+    // Keep mixed samples (off = mix and discard, for pure cost benchmarks)
+    void setKeepSamples(bool keep) noexcept;
+
+    // Results
+    int tick() const noexcept;
+    const std::vector<std::int16_t>& samples() const noexcept; // interleaved L/R
+    const std::vector<CapturedTrigger>& triggers() const noexcept;
+    std::vector<CapturedTrigger> triggersAt(int tick) const;
+    const std::string& soundId(SoundHandle handle) const;
+    long long mixTimeNs() const noexcept; // total time spent mixing
+    int peakVoices() const noexcept;
+
+    bool writeWav(const std::string& path) const;
+    void clearCapture();
+
+private:
+    struct Clip {
+        std::string id;
+        std::vector<std::int16_t> owned; // decoded WAV data (empty for packed PCM)
+        const std::int16_t* frames;      // interleaved stereo
+        std::size_t frameCount;
+    };
+
+    struct Voice {
+        SoundHandle handle;
+        std::size_t cursor; // next frame
+    };
+
+    void mixTick();
+
+    int sampleRate_;
+    int ticksPerSecond_;
+    int maxVoices_;
+    bool muted_{false};
+    bool keepSamples_{true};
+    int tick_{0};
+    int peakVoices_{0};
+    long long mixTimeNs_{0};
+
+    std::vector<Clip> clips_;
+    std::unordered_map<std::string, SoundHandle> handles_;
+    std::vector<Voice> voices_;
+    TrackingResource* memory_{nullptr}; // sample and mix buffers are reported here
+    std::vector<std::int32_t> mixBuffer_; // one tick, widened to avoid clipping mid-mix
+    std::vector<std::int16_t> samples_;
+    std::vector<CapturedTrigger> triggers_;
+};
+
 // Silent implementation (for testing or disabled audio)
 class NullSoundSystem final : public SoundSystem {
 public:
     NullSoundSystem() = default;
     ~NullSoundSystem() override = default;
 
-    void play(const std::string&) override;
+    using SoundSystem::play;
+    void play(SoundHandle) override;
     void stopAll() override;
 
     void setMuted(bool muted) override;
@@ -109,6 +348,7 @@ private:
 enum class SoundBackend {
     Terminal,  // ncurses beep/flash
     SDL,       // SDL2_mixer (real audio files)
+    Capture,   // Offline software mix into memory
     Null       // Silent
 };
 
@@ -116,6 +356,8 @@ inline std::unique_ptr<SoundSystem> createSoundSystem(SoundBackend backend = Sou
     switch (backend) {
         case SoundBackend::SDL:
             return std::make_unique<SDLSoundSystem>();
+        case SoundBackend::Capture:
+            return std::make_unique<CaptureSoundSystem>();
         case SoundBackend::Null:
             return std::make_unique<NullSoundSystem>();
         case SoundBackend::Terminal:
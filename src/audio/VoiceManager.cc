@@ -0,0 +1,89 @@
+export module audio.voices;
+
+import <atomic>;
+import <cstdint>;
+import <memory>;
+import <vector>;
+
+import audio.handle;
+
+export namespace age {
+
+// Playback policy for one sound
+struct SoundPolicy {
+    int maxVoices{4};       // concurrent instances of this sound
+    int minRetriggerMs{30}; // re-triggers sooner than this are dropped
+    int priority{0};        // higher may steal voices from lower
+};
+
+// Result of a voice request
+struct VoiceDecision {
+    int channel{-1};     // mixer channel to play on, -1 = drop the request
+    bool steal{false};   // channel is busy with a lower-priority voice: halt it first
+};
+
+// Counters since construction (read on the audio thread)
+struct VoiceStats {
+    std::uint64_t requested{0};
+    std::uint64_t played{0};
+    std::uint64_t throttled{0}; // inside minRetriggerMs
+    std::uint64_t limited{0};   // sound already at maxVoices
+    std::uint64_t stolen{0};    // lower-priority voices cut off
+    std::uint64_t dropped{0};   // no free voice and nothing to steal
+};
+
+// Decides which sound requests get a mixer channel
+// Lives on the audio thread and knows nothing about SDL: it tracks one voice
+// per channel, enforces per-sound voice limits and retrigger intervals and a
+// global polyphony cap, and when every voice is busy steals the oldest voice
+// of the lowest priority below the request's. Audio CPU is bounded by the
+// polyphony cap however many events fire.
+class VoiceManager {
+public:
+    explicit VoiceManager(int polyphony = 16);
+
+    void setPolyphony(int voices);
+    int polyphony() const noexcept;
+
+    void setPolicy(SoundHandle handle, const SoundPolicy& policy);
+    const SoundPolicy& policy(SoundHandle handle) const;
+    void setDefaultPolicy(const SoundPolicy& policy);
+
+    VoiceDecision acquire(SoundHandle handle, long long nowNs);
+
+    // Safe to call from the mixer's channel-finished callback (another thread);
+    // finished voices are reclaimed on the next acquire()
+    void release(int channel) noexcept;
+
+    void releaseAll() noexcept;
+
+    int activeVoices() const noexcept;
+    const VoiceStats& stats() const noexcept;
+
+private:
+    struct Voice {
+        SoundHandle handle;
+        int priority;
+        long long startNs;
+        bool active;
+    };
+
+    struct SoundState {
+        SoundPolicy policy;
+        int activeVoices;
+        long long lastStartNs;
+    };
+
+    void reapFinished() noexcept;
+    SoundState& stateFor(SoundHandle handle);
+
+    int polyphony_;
+    SoundPolicy defaultPolicy_;
+    std::vector<Voice> voices_;          // one per mixer channel
+    std::vector<SoundState> sounds_;     // indexed by handle
+    std::unique_ptr<std::atomic<bool>[]> finished_; // set by release()
+    int activeVoices_{0};
+    VoiceStats stats_;
+};
+
+}
@@ -0,0 +1,77 @@
+module;
+#include <ncurses.h>
+
+export module controller.async;
+
+import <atomic>;
+import <cstdint>;
+import <thread>;
+import <vector>;
+
+import controller;
+import core.clock;
+import core.input_event;
+import core.spsc_queue;
+
+export namespace age {
+
+// Input event stamped with the monotonic time it was read
+struct TimedInput {
+    InputEvent event;
+    long long timestampNs;
+};
+
+// Read-to-drain latency of keys delivered by AsyncController
+struct InputLatencyStats {
+    std::uint64_t samples{0};
+    std::uint64_t dropped{0}; // keys lost because the queue was full
+    long long lastNs{0};
+    long long meanNs{0};
+    long long maxNs{0};
+};
+
+// Controller that reads stdin on a dedicated thread
+// The reader blocks in poll() on the input fd, timestamps each decoded key
+// with Clock::nowNs() and pushes it into a lock-free SPSC queue. The engine
+// drains the queue at the start of each tick via pollInput(), so a key is
+// never older than one tick when the game sees it.
+// Replaces CursesController; ncurses must not read the same fd (no getch()).
+class AsyncController final : public Controller {
+public:
+    explicit AsyncController(int fd = 0, std::size_t queueCapacity = 256);
+    ~AsyncController() override;
+
+    // Non-copyable (owns a thread)
+    AsyncController(const AsyncController&) = delete;
+    AsyncController& operator=(const AsyncController&) = delete;
+
+    InputEvent getInput() override;
+    void pollInput(InputState& state) override;
+
+    // Latency statistics (updated on the game thread while draining)
+    const InputLatencyStats& latencyStats() const noexcept;
+    void resetLatencyStats() noexcept;
+
+private:
+    void readerLoop();
+
+    // Decode raw bytes (including ESC [ A style sequences) into key codes
+    // Returns the number of bytes consumed, 0 if the sequence is incomplete
+    std::size_t decodeKey(const unsigned char* bytes, std::size_t len, int& key) const;
+
+    void recordLatency(long long timestampNs);
+
+    int fd_;
+    int wakePipe_[2]{-1, -1}; // lets the destructor interrupt poll()
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+    SpscQueue<TimedInput> queue_;
+    std::thread reader_;
+
+    // Reader-thread only: bytes of a partially received escape sequence
+    std::vector<unsigned char> pendingBytes_;
+
+    InputLatencyStats stats_;
+};
+
+}
@@ -15,6 +15,13 @@ class Controller {
 public:
     virtual ~Controller() = default;
     virtual InputEvent getInput() = 0;
+
+    // Drain all input pending this tick into state
+    // Default feeds a single getInput(); backends that can buffer should drain fully
+    virtual void pollInput(InputState& state);
+
+    // True once the input source has ended (e.g. a replay log); stops Engine::run
+    virtual bool finished() const;
 };
 
 // Ncurses-based input controller
@@ -24,6 +31,9 @@ public:
     ~CursesController() override = default;
 
     InputEvent getInput() override;
+
+    // Reads getch() until ERR so key-repeat never backs up in the ncurses buffer
+    void pollInput(InputState& state) override;
 };
 
 }
@@ -0,0 +1,28 @@
+export module controller.fuzz;
+
+import <cstdint>;
+import <random>;
+import <vector>;
+
+import controller;
+import core.input_event;
+
+export namespace age {
+
+// Seeded random input for bots and fuzzing (no terminal needed)
+// Each tick every key in the set is independently pressed with
+// pressChance, so the same seed always produces the same input stream.
+class FuzzController final : public Controller {
+public:
+    FuzzController(std::uint32_t seed, std::vector<int> keys, float pressChance = 0.1f);
+
+    InputEvent getInput() override;
+    void pollInput(InputState& state) override;
+
+private:
+    std::mt19937 rng_;
+    std::vector<int> keys_;
+    std::bernoulli_distribution press_;
+};
+
+}
@@ -1,6 +1,10 @@
 export module core.input_event;
 
+import <array>;
+import <bitset>;
+import <cstdint>;
 import <variant>;
+import <vector>;
 
 import core.position;
 
@@ -30,4 +34,49 @@ inline const KeyboardInput* getKeyboardInput(const InputEvent& ev) {
     return std::get_if<KeyboardInput>(&ev);
 }
 
+// Per-tick keyboard state built from every key drained in that tick
+// Terminals only report presses (plus auto-repeat), so a key stays held
+// while repeats keep arriving and is released once none arrive for
+// releaseTicks ticks. Repeats arriving inside that window never show up as
+// pressed(); the first repeat after the auto-repeat delay (typically
+// 250-500 ms) does unless releaseTicks covers the delay.
+class InputState {
+public:
+    // Covers ASCII and every ncurses KEY_* code (KEY_MAX is 0777)
+    static constexpr int KeyCount = 512;
+
+    explicit InputState(int releaseTicks = 4);
+
+    // Frame lifecycle (driven by the Engine each tick)
+    void beginTick();
+    void feed(const InputEvent& event);
+    void endTick();
+    // Drop pressed/released edges and raw events but keep held keys, so
+    // catch-up steps after the first in a frame see held input only once
+    void clearEdges() noexcept;
+
+    // Queries (O(1), out-of-range keys are never pressed/held)
+    bool pressed(int key) const noexcept;   // went down this tick
+    bool held(int key) const noexcept;      // down this tick (pressed or repeating)
+    bool released(int key) const noexcept;  // went up this tick
+    bool anyPressed() const noexcept;
+
+    // Raw events drained this tick, in arrival order
+    const std::vector<InputEvent>& events() const noexcept;
+
+    // First event of the tick (NoInput if none), for single-event consumers
+    InputEvent first() const;
+
+    void setReleaseTicks(int ticks) noexcept;
+    void reset();
+
+private:
+    std::bitset<KeyCount> pressed_;
+    std::bitset<KeyCount> held_;
+    std::bitset<KeyCount> released_;
+    std::array<std::uint8_t, KeyCount> idleTicks_{};
+    std::vector<InputEvent> events_;
+    int releaseTicks_;
+};
+
 }
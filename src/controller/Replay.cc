@@ -0,0 +1,106 @@
+export module controller.replay;
+
+import <cstdint>;
+import <fstream>;
+import <string>;
+import <vector>;
+
+import controller;
+import core.input_event;
+
+export namespace age {
+
+// Binary input log layout
+// Header: magic "AGER", version, RNG seed, simulation rate, hash interval.
+// Ticks are simulation steps, so the rate is the one they were taken at.
+// Body: a stream of tagged records, integers LEB128 varint encoded. Runs of
+// ticks without input collapse into a single IdleTicks record, so a typical
+// session costs a few bytes per second of play.
+namespace replay_format {
+    inline constexpr std::uint32_t Magic = 0x52454741; // "AGER"
+    // 2: header stores simulation rate
+    // 3: collision events come from the broad phase in grid order, and swept
+    //    entities report their earliest contact, so older logs no longer
+    //    reproduce their recorded state hashes
+    inline constexpr std::uint16_t Version = 3;
+
+    enum class Record : std::uint8_t {
+        IdleTicks = 0, // varint n: n ticks with no input
+        Keys = 1,      // varint count, then count varint key codes (one tick)
+        Hash = 2,      // varint tick, 8 byte World::stateHash()
+        Seed = 3,      // 4 byte seed: RNG reseeded at this point
+        End = 4
+    };
+}
+
+// Appends each tick's input (and periodic state hashes) to a log file
+class InputRecorder {
+public:
+    InputRecorder(const std::string& path, std::uint32_t seed, int simulationRate, int hashInterval = 60);
+    ~InputRecorder(); // writes End and flushes
+
+    // Non-copyable (owns the output stream)
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    void recordTick(const InputState& input);
+    void recordHash(int tick, std::uint64_t hash);
+    void recordSeed(std::uint32_t seed);
+    void flush();
+
+    int hashInterval() const noexcept;
+    bool isOpen() const noexcept;
+
+private:
+    void flushIdle();
+    void writeVarint(std::uint64_t value);
+    void writeRecord(replay_format::Record record);
+
+    std::ofstream out_;
+    std::vector<std::uint8_t> buffer_; // flushed in blocks, not per tick
+    int hashInterval_;
+    std::uint64_t idleTicks_{0};
+};
+
+// Controller that feeds a recorded log back tick by tick
+// Paired with the same seed, the World reaches identical state; the Engine
+// compares World::stateHash() against recorded hashes and reports the first
+// tick where they differ.
+class ReplayController final : public Controller {
+public:
+    explicit ReplayController(const std::string& path);
+
+    InputEvent getInput() override;
+    void pollInput(InputState& state) override;
+    bool finished() const override;
+
+    // Header contents
+    std::uint32_t seed() const noexcept;
+    int simulationRate() const noexcept;
+    int hashInterval() const noexcept;
+    bool isValid() const noexcept;
+
+    // Check a state hash for a tick; returns false (and remembers the tick)
+    // on the first mismatch. Ticks without a recorded hash always pass.
+    bool verifyHash(int tick, std::uint64_t hash);
+    int divergedTick() const noexcept; // -1 while in sync
+
+private:
+    std::uint64_t readVarint();
+    void advanceTick(InputState& state);
+
+    std::vector<std::uint8_t> data_; // whole log, read once at construction
+    std::size_t cursor_{0};
+    std::uint32_t seed_{0};
+    int simulationRate_{60};
+    int hashInterval_{0};
+    bool valid_{false};
+    bool finished_{false};
+
+    std::uint64_t idleRemaining_{0};
+    int nextHashTick_{-1};
+    std::uint64_t nextHash_{0};
+    int divergedTick_{-1};
+};
+
+}
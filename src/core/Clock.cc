@@ -3,10 +3,31 @@ module;
 
 export module core.clock;
 
+import <cstdint>;
+
 export namespace age {
 
+// Frame pacing statistics (all times in nanoseconds)
+// Jitter is the wake time relative to the ideal deadline of that tick,
+// overshoot is how far past the deadline the loop actually resumed.
+struct PacingStats {
+    std::uint64_t ticks{0};
+    std::uint64_t missedDeadlines{0}; // ticks that started over a full tick late
+    long long lastJitterNs{0};
+    long long meanJitterNs{0};        // mean absolute jitter
+    long long maxJitterNs{0};
+    long long lastOvershootNs{0};
+    long long meanOvershootNs{0};
+    long long maxOvershootNs{0};
+};
+
 class Clock {
 public:
+    enum class PacingMode {
+        Relative, // sleep for the remaining time each tick (drifts with wakeup latency)
+        Precise   // absolute deadlines + calibrated spin, drift corrected
+    };
+
     explicit Clock(float tickDuration = 0.05f);
 
     float tick();
@@ -14,12 +35,38 @@ public:
     float tickDuration() const noexcept;
     void reset();
 
+    // Monotonic time in nanoseconds (CLOCK_MONOTONIC)
+    static long long nowNs();
+
+    // Pacing mode (Relative by default)
+    // Precise sleeps with clock_nanosleep(TIMER_ABSTIME) to just before the
+    // deadline, then spins the last spinWindowNs. Deadlines advance by exactly
+    // one tick so wakeup latency never accumulates; after a stall longer than
+    // a tick the schedule is rebased instead of bursting to catch up.
+    void setPacingMode(PacingMode mode) noexcept;
+    PacingMode pacingMode() const noexcept;
+
+    // Measure scheduler wakeup latency and size the spin window from it
+    void calibrate(int samples = 50);
+    void setSpinWindowNs(long long ns) noexcept;
+    long long spinWindowNs() const noexcept;
+
+    const PacingStats& pacingStats() const noexcept;
+    void resetPacingStats() noexcept;
+
 private:
     float tickDuration_;
     long long lastTickNs_;
 
-    static long long nowNs();
+    PacingMode mode_{PacingMode::Relative};
+    long long nextDeadlineNs_{0};
+    long long spinWindowNs_{200000}; // 200us until calibrated
+    PacingStats stats_;
+
     static void sleepNs(long long ns);
+    static void sleepUntilNs(long long deadlineNs);
+    void sleepPrecise();
+    void recordWake(long long deadlineNs, long long wakeNs) noexcept;
 };
 
 }
@@ -0,0 +1,27 @@
+export module core.hash;
+
+import <cstdint>;
+import <string_view>;
+
+export namespace age {
+
+// 64-bit FNV-1a, constexpr so ids can be hashed at compile time
+inline constexpr std::uint64_t hashId(std::string_view id) noexcept {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : id) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Resource id paired with its precomputed hash, for repeated lookups
+// e.g. static constexpr IdKey kBird{"bird"}; resources.getShape(kBird);
+struct IdKey {
+    std::string_view id;
+    std::uint64_t hash;
+
+    constexpr explicit IdKey(std::string_view s) noexcept : id(s), hash(hashId(s)) {}
+};
+
+}
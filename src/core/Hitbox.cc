@@ -23,6 +23,14 @@ public:
                     const Position& selfPos,
                     const Position& otherPos) const noexcept;
 
+    // Continuous test over one tick: both hitboxes move linearly from their
+    // "from" to their "to" positions. Returns the fraction of the tick in
+    // [0, 1] at first contact, or a negative value if they never touch
+    // (slab test of the relative motion against the expanded box).
+    float sweep(const Hitbox& other,
+                const Position& selfFrom, const Position& selfTo,
+                const Position& otherFrom, const Position& otherTo) const noexcept;
+
 private:
     int offsetX_{0};
     int offsetY_{0};
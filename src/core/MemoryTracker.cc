@@ -0,0 +1,128 @@
+export module core.memory;
+
+import <array>;
+import <atomic>;
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+import <memory_resource>;
+import <string>;
+import <vector>;
+
+export namespace age {
+
+// Snapshot of one subsystem's counters
+struct MemoryStats {
+    std::size_t liveBytes{0};
+    std::size_t peakBytes{0};
+    std::uint64_t totalAllocations{0};
+    std::uint64_t allocationsLastTick{0};
+};
+
+// Memory resource that counts what a subsystem allocates
+// Forwards to an upstream resource and tracks live/peak bytes and
+// allocations per tick. Subsystems route their containers and objects
+// through it (pmr containers, allocate_shared); memory owned by third-party
+// libraries (SDL chunks, ncurses) is reported with recordExternal().
+// Counters are atomic because audio and loader threads allocate too.
+class TrackingResource final : public std::pmr::memory_resource {
+public:
+    explicit TrackingResource(std::string name,
+                              std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    // Non-copyable, non-movable (containers keep pointers to it)
+    TrackingResource(const TrackingResource&) = delete;
+    TrackingResource& operator=(const TrackingResource&) = delete;
+
+    const std::string& name() const noexcept;
+    MemoryStats stats() const noexcept;
+
+    // Bytes allocated outside the resource (negative when released)
+    void recordExternal(std::ptrdiff_t bytes, bool countsAsAllocation = true) noexcept;
+
+    // Close the current tick's allocation count (called by MemoryTracker)
+    void endTick() noexcept;
+
+    // Allocations per tick above which the overlay flags this subsystem
+    // (0 = no budget); a steady-state game loop should stay at its budget
+    void setTickBudget(std::uint64_t allocations) noexcept;
+    bool overBudget() const noexcept;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void addLive(std::ptrdiff_t bytes) noexcept;
+
+    std::string name_;
+    std::pmr::memory_resource* upstream_;
+    std::atomic<std::size_t> liveBytes_{0};
+    std::atomic<std::size_t> peakBytes_{0};
+    std::atomic<std::uint64_t> totalAllocations_{0};
+    std::atomic<std::uint64_t> tickAllocations_{0};
+    std::atomic<std::uint64_t> lastTickAllocations_{0};
+    std::uint64_t tickBudget_{0};
+};
+
+// Allocator that keeps its TrackingResource alive (allocate_shared)
+// The control block of a shared_ptr built with it holds a reference to the
+// resource, so an object may outlive the MemoryTracker that created it and
+// still free through the right resource.
+template<typename T>
+class SharedResourceAllocator {
+public:
+    using value_type = T;
+
+    explicit SharedResourceAllocator(std::shared_ptr<TrackingResource> resource) noexcept;
+    template<typename U>
+    SharedResourceAllocator(const SharedResourceAllocator<U>& other) noexcept;
+
+    T* allocate(std::size_t count);
+    void deallocate(T* p, std::size_t count) noexcept;
+
+    const std::shared_ptr<TrackingResource>& resource() const noexcept;
+
+    template<typename U>
+    bool operator==(const SharedResourceAllocator<U>& other) const noexcept;
+
+private:
+    std::shared_ptr<TrackingResource> resource_;
+};
+
+// Per-Engine set of tracked subsystems (no global state, so farm instances
+// each account for themselves)
+class MemoryTracker {
+public:
+    enum class Subsystem : std::uint8_t {
+        World,
+        Events,
+        Resources,
+        Sound,
+        View,
+        Count
+    };
+
+    MemoryTracker();
+
+    TrackingResource& resource(Subsystem subsystem) noexcept;
+    const TrackingResource& resource(Subsystem subsystem) const noexcept;
+    // Shared ownership, for allocations that may outlive the Engine (entities)
+    std::shared_ptr<TrackingResource> share(Subsystem subsystem) const noexcept;
+    MemoryStats stats(Subsystem subsystem) const noexcept;
+    MemoryStats total() const noexcept;
+
+    // Roll every subsystem's per-tick counter (Engine calls this after each step)
+    void endTick() noexcept;
+
+    // One overlay line per subsystem plus a total, e.g.
+    // "mem world   live 412K  peak 530K  allocs/tick 3"; over-budget lines end in " !"
+    void appendStatusLines(std::vector<std::string>& out) const;
+
+private:
+    static constexpr std::size_t SubsystemCount = static_cast<std::size_t>(Subsystem::Count);
+
+    std::array<std::shared_ptr<TrackingResource>, SubsystemCount> resources_;
+};
+
+}
@@ -0,0 +1,102 @@
+export module core.snapshot;
+
+import <cstddef>;
+import <cstdint>;
+import <string>;
+import <string_view>;
+import <unordered_map>;
+import <vector>;
+
+export namespace age {
+
+// On-disk / in-memory snapshot layout (little-endian, no padding between records)
+//   Header | string table | body
+// Strings (tags, shape ids) are written once to the table and referenced
+// by index from the body, so entities cost a few fixed-size fields each.
+namespace snapshot_format {
+    inline constexpr char Magic[4] = {'A', 'G', 'S', 'S'};
+    // 2: entities carry the continuous-collision flag, movement kinds
+    //    include FlowField
+    inline constexpr std::uint32_t Version = 2;
+    inline constexpr std::uint32_t NoString = 0xFFFFFFFFu;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t stringCount;
+        std::uint32_t stringBytes; // size of the string table block
+        std::uint64_t bodyBytes;
+    };
+}
+
+// Finished snapshot bytes (quick-save slot, rewind ring entry...)
+class Snapshot {
+public:
+    Snapshot() = default;
+
+    std::vector<std::byte>& bytes() noexcept;
+    const std::vector<std::byte>& bytes() const noexcept;
+    bool empty() const noexcept;
+
+    bool writeFile(const std::string& path) const;
+    bool readFile(const std::string& path);
+
+private:
+    std::vector<std::byte> data_;
+};
+
+// Builds a snapshot into a reusable byte buffer
+// Values must be trivially copyable; they are copied bytewise, so a
+// snapshot is only portable between builds of the same engine.
+class SnapshotWriter {
+public:
+    SnapshotWriter() = default;
+
+    // Drop previous contents but keep capacity (rewind buffers reuse memory)
+    void reset();
+
+    template<typename T>
+    void write(const T& value);
+    void writeBytes(const void* data, std::size_t size);
+
+    // Index into the string table; repeated strings share one entry
+    std::uint32_t intern(std::string_view text);
+    void writeString(std::string_view text); // as an interned index
+
+    // Assemble header + string table + body into out (capacity is reused)
+    void finish(std::vector<std::byte>& out) const;
+
+    std::size_t bodySize() const noexcept;
+
+private:
+    std::vector<std::byte> body_;
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, std::uint32_t> stringIndex_;
+};
+
+// Bounds-checked cursor over a finished snapshot
+// Any short read or bad string index clears ok(); callers check once at the end.
+class SnapshotReader {
+public:
+    SnapshotReader(const std::byte* data, std::size_t size);
+
+    template<typename T>
+    bool read(T& value);
+    bool readBytes(void* data, std::size_t size);
+
+    // Reads an interned index; NoString yields an empty string
+    const std::string& readString();
+    bool readStringIndex(std::uint32_t& index);
+
+    const std::vector<std::string>& strings() const noexcept;
+    bool ok() const noexcept;
+    bool atEnd() const noexcept;
+
+private:
+    std::vector<std::string> strings_;
+    const std::byte* cursor_{nullptr};
+    const std::byte* end_{nullptr};
+    bool ok_{false};
+};
+
+}
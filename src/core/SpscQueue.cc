@@ -0,0 +1,41 @@
+export module core.spsc_queue;
+
+import <atomic>;
+import <cstddef>;
+import <vector>;
+
+export namespace age {
+
+// Bounded lock-free single-producer/single-consumer ring buffer
+// Exactly one thread may push and one (other) thread may pop concurrently.
+// Capacity is rounded up to a power of two so indices wrap with a mask,
+// and head/tail live on separate cache lines to avoid false sharing.
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(std::size_t capacity = 1024);
+
+    // Non-copyable, non-movable (atomics are shared between threads)
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side; returns false (item dropped) when the queue is full
+    bool push(const T& item);
+    bool push(T&& item);
+
+    // Consumer side; returns false when the queue is empty
+    bool pop(T& out);
+
+    // Approximate when called from a thread other than the consumer
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+    std::size_t capacity() const noexcept;
+
+private:
+    std::vector<T> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> head_{0}; // next slot to pop (consumer-owned)
+    alignas(64) std::atomic<std::size_t> tail_{0}; // next slot to push (producer-owned)
+};
+
+}
@@ -3,9 +3,12 @@ export module events.event;
 import <memory>;
 import <string>;
 
+import audio.handle;
+
 export namespace age {
 
 // Abstract class for all game events
+// Concrete events also expose a static TypeName matching type()
 class Event {
 public:
     virtual ~Event() = default;
@@ -15,7 +18,9 @@ public:
 // Concrete event for entity collisions
 class CollisionEvent final : public Event {
 public:
-    CollisionEvent(int entityA, int entityB, const std::string& tagA, const std::string& tagB);
+    static constexpr const char* TypeName = "collision";
+
+    CollisionEvent(int entityA, int entityB, const std::string& tagA, const std::string& tagB, float time = 1.0f);
 
     const char* type() const noexcept override;
 
@@ -23,6 +28,9 @@ public:
     int entityBId() const;
     const std::string& tagA() const;
     const std::string& tagB() const;
+    // Fraction of the tick at first contact (1 for end-of-tick overlaps;
+    // earlier for swept hits found by continuous collision)
+    float time() const;
 
     // Check if collision involves a specific tag
     bool involves(const std::string& tag) const;
@@ -35,11 +43,14 @@ private:
     int entityBId_;
     std::string tagA_;
     std::string tagB_;
+    float time_;
 };
 
 // Concrete event for game over
 class GameOverEvent final : public Event {
 public:
+    static constexpr const char* TypeName = "game_over";
+
     explicit GameOverEvent(bool won, const std::string& reason = "");
 
     const char* type() const noexcept override;
@@ -53,21 +64,28 @@ private:
 };
 
 // Concrete event for playing a sound
+// Prefer the handle form: it carries no string and plays without a lookup
 class SoundEvent final : public Event {
 public:
-    explicit SoundEvent(const std::string& soundId);
+    static constexpr const char* TypeName = "sound";
+
+    // Carries only the handle (resolve ids once with findSound()); for a
+    // one-off sound by id, call SoundSystem::play(id) directly
+    explicit SoundEvent(SoundHandle handle);
 
     const char* type() const noexcept override;
 
-    const std::string& soundId() const;
+    SoundHandle handle() const;
 
 private:
-    std::string soundId_;
+    SoundHandle handle_;
 };
 
 // Concrete event for entity hitting the world border
 class BorderEvent final : public Event {
 public:
+    static constexpr const char* TypeName = "border";
+
     enum class Side { Left, Right, Top, Bottom };
 
     BorderEvent(int entityId, Side side);
@@ -82,4 +100,26 @@ private:
     Side side_;
 };
 
+// Concrete event for a solid/trigger entity overlapping a solid tile
+class TileCollisionEvent final : public Event {
+public:
+    static constexpr const char* TypeName = "tile_collision";
+
+    TileCollisionEvent(int entityId, const std::string& tag, int x, int y);
+
+    const char* type() const noexcept override;
+
+    int entityId() const;
+    const std::string& tag() const;
+    // First blocked world cell found under the entity's hitbox
+    int x() const;
+    int y() const;
+
+private:
+    int entityId_;
+    std::string tag_;
+    int x_;
+    int y_;
+};
+
 }
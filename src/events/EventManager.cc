@@ -1,10 +1,13 @@
 export module events.manager;
 
 import <functional>;
+import <cstddef>;
 import <memory>;
+import <memory_resource>;
 import <string>;
 import <vector>;
 
+import core.memory;
 import events.event;
 
 export namespace age {
@@ -15,8 +18,14 @@ using EventCallback = std::function<void(const Event&)>;
 // Pub/sub system for game events
 class EventManager {
 public:
-    EventManager() = default;
-    ~EventManager() = default;
+    // Events built by emit<T>() and the pending queue allocate from memory
+    // (nullptr = default heap); events passed in as unique_ptr are adopted
+    explicit EventManager(TrackingResource* memory = nullptr);
+    ~EventManager(); // destroys events still pending (clearPending)
+
+    // Non-copyable (the queue owns its events)
+    EventManager(const EventManager&) = delete;
+    EventManager& operator=(const EventManager&) = delete;
 
     // Subscribe to events of a specific type
     // Returns a subscription ID that can be used to unsubscribe
@@ -50,6 +59,9 @@ public:
     // Get count of pending events
     size_t pendingCount() const;
 
+    // Events dispatched by the last processEvents() call
+    size_t processedCount() const;
+
 private:
     struct Subscription {
         int id;
@@ -57,10 +69,22 @@ private:
         EventCallback callback;
     };
 
+    // Owning entry: destroyed and freed by release() through the resource
+    // it was allocated from
+    struct PendingEvent {
+        Event* event;
+        std::pmr::memory_resource* resource; // nullptr = adopted unique_ptr (heap)
+        std::size_t size;
+        std::size_t align;
+    };
+
     void dispatch(const Event& event);
+    void release(PendingEvent& pending) noexcept;
 
     std::vector<Subscription> subscriptions_;
-    std::vector<std::unique_ptr<Event>> pendingEvents_;
+    std::pmr::vector<PendingEvent> pendingEvents_;
+    TrackingResource* memory_; // (owned externally by Engine)
+    size_t processedCount_{0};
     int nextId_{1};
 };
 
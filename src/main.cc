@@ -1,21 +1,141 @@
+import <cstdint>;
+import <iostream>;
+import <memory>;
+import <stdexcept>;
 import <string>;
+import <vector>;
+
+import controller;
+import controller.fuzz;
+import engine;
+import sim.farm;
 
 namespace age {
 
-void runFlappyBird();
-void runSpaceInvaders();
+SessionResult runFlappyBird(const SessionOptions& options);
+SessionResult runSpaceInvaders(const SessionOptions& options);
+
+}
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program << " [-g1|-g2] [--record <file>] [--replay <file>] [--headless]\n"
+              << "       [--hot-reload] [--async-input] [--capture-audio <file.wav>] [--stats]\n"
+              << "       [--farm <instances> [--threads <n>] [--ticks <n>] [--seed <n>]]\n";
+}
+
+// Whole-string decimal parse; false on junk, overflow or a value below min
+bool parseInt(const std::string& text, int min, int& out) {
+    try {
+        std::size_t used = 0;
+        int value = std::stoi(text, &used);
+        if (used != text.size() || value < min) return false;
+        out = value;
+        return true;
+    } catch (const std::logic_error&) { // invalid_argument, out_of_range
+        return false;
+    }
+}
+
+bool parseSeed(const std::string& text, std::uint32_t& out) {
+    try {
+        std::size_t used = 0;
+        long long value = std::stoll(text, &used);
+        if (used != text.size() || value < 0 || value > 0xFFFFFFFFLL) return false;
+        out = static_cast<std::uint32_t>(value);
+        return true;
+    } catch (const std::logic_error&) {
+        return false;
+    }
+}
 
 }
 
 int main(int argc, char* argv[]) {
     std::string mode = "-g1"; // default to Flappy Bird
     if (argc >= 2) mode = argv[1];
+    if (mode != "-g1" && mode != "-g2") {
+        std::cerr << "unknown game: " << mode << "\n";
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Optional session flags: --record <file>, --replay <file>, --headless,
+    // --hot-reload, --capture-audio <file.wav>, --async-input, --stats
+    // Farm flags: --farm <instances> [--threads <n>] [--ticks <n>] [--seed <n>]
+    age::SessionOptions options;
+    age::FarmOptions farm;
+    int farmInstances = 0;
+    bool printStats = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool takesValue = arg == "--record" || arg == "--replay" || arg == "--capture-audio" ||
+                          arg == "--farm" || arg == "--threads" || arg == "--ticks" || arg == "--seed";
+        if (takesValue && i + 1 >= argc) {
+            std::cerr << arg << " needs a value\n";
+            printUsage(argv[0]);
+            return 1;
+        }
 
-    if (mode == "-g1") {
-        age::runFlappyBird();
-    } else if (mode == "-g2") {
-        age::runSpaceInvaders();
+        bool valid = true;
+        if (arg == "--record") {
+            options.recordPath = argv[++i];
+        } else if (arg == "--replay") {
+            options.replayPath = argv[++i];
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--hot-reload") {
+            options.hotReload = true;
+        } else if (arg == "--async-input") {
+            options.asyncInput = true;
+        } else if (arg == "--stats") {
+            printStats = true;
+        } else if (arg == "--capture-audio") {
+            options.audioCapturePath = argv[++i];
+        } else if (arg == "--farm") {
+            valid = parseInt(argv[++i], 0, farmInstances);
+        } else if (arg == "--threads") {
+            valid = parseInt(argv[++i], 0, farm.threads);
+        } else if (arg == "--ticks") {
+            valid = parseInt(argv[++i], 0, farm.maxTicks);
+        } else if (arg == "--seed") {
+            valid = parseSeed(argv[++i], farm.baseSeed);
+        } else {
+            std::cerr << "unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!valid) {
+            std::cerr << "invalid value for " << arg << ": " << argv[i] << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
     }
 
+    age::SessionFunction game = mode == "-g2" ? age::runSpaceInvaders : age::runFlappyBird;
+
+    if (farmInstances <= 0) {
+        age::SessionResult result = game(options);
+        if (printStats) {
+            std::cout << "first frame: " << result.firstFrameNs / 1000 << " us\n";
+        }
+        return 0;
+    }
+
+    // Headless simulation farm driven by seeded random input
+    farm.instances = farmInstances;
+    farm.makeController = [](std::uint32_t seed) -> std::unique_ptr<age::Controller> {
+        return std::make_unique<age::FuzzController>(seed, std::vector<int>{' ', 'w', 's'});
+    };
+    age::SimulationFarm runner(game);
+    age::FarmStats stats = runner.run(farm);
+
+    std::cout << "sessions: " << stats.sessions
+              << " | wins: " << stats.wins
+              << " | ticks: " << stats.totalTicks
+              << " | ticks/s: " << static_cast<long long>(stats.ticksPerSecond)
+              << " | score min/mean/max: " << stats.minScore << "/" << stats.meanScore << "/" << stats.maxScore
+              << "\n";
     return 0;
 }
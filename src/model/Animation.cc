@@ -1,7 +1,10 @@
 export module entity.animation;
 
+import <cstdint>;
+import <string>;
 import <vector>;
 
+import core.snapshot;
 import render.shape;
 
 export namespace age {
@@ -37,6 +40,11 @@ public:
     void setLooping(bool loop);
     bool isLooping() const;
 
+    // Snapshot support; frame shapes are written by sprite id and resolved
+    // on restore through shapes (indexed by snapshot string index)
+    void save(SnapshotWriter& out) const;
+    bool restore(SnapshotReader& in, const std::vector<const Shape*>& shapes);
+
 private:
     std::vector<Frame> frames_;
     std::size_t currentIndex_;
@@ -44,4 +52,45 @@ private:
     bool looping_;
 };
 
+// Immutable frame sequence registered once in the ResourceManager and
+// shared by every entity that plays it
+class AnimationClip {
+public:
+    AnimationClip(std::string id, std::vector<Frame> frames, bool looping = true);
+
+    const std::string& id() const noexcept;
+    const std::vector<Frame>& frames() const noexcept;
+    const Frame& frame(std::size_t index) const;
+    bool isLooping() const noexcept;
+    int totalTicks() const noexcept;
+
+    // Frame showing at a tick offset from the start (binary search over
+    // frame end ticks); non-looping clips hold their last frame
+    std::size_t frameAt(long long tick) const;
+
+private:
+    std::string id_;
+    std::vector<Frame> frames_;
+    std::vector<int> frameEndTicks_; // prefix sums of durationTicks
+    int totalTicks_;
+    bool looping_;
+};
+
+using ClipId = std::uint32_t;
+inline constexpr ClipId InvalidClip = 0xFFFFFFFFu;
+
+// Per-entity playback position in a shared clip (12 bytes)
+// Synchronized cursors ignore frame/tick and derive the frame from the
+// World's tick count plus phase, so a whole grid animates in step with no
+// per-entity counters.
+struct AnimationCursor {
+    ClipId clip{InvalidClip};
+    std::uint16_t frame{0};
+    bool synchronized{false};
+    bool finished{false};
+    std::int32_t tick{0};  // ticks spent in frame, or phase when synchronized
+
+    bool active() const noexcept { return clip != InvalidClip; }
+};
+
 }
@@ -0,0 +1,134 @@
+module;
+#include <sys/mman.h>
+
+export module resources.pack;
+
+import <cstddef>;
+import <cstdint>;
+import <string>;
+import <string_view>;
+import <vector>;
+
+import core.hash;
+
+export namespace age {
+
+// On-disk layout of an asset pack (all integers little-endian)
+// [Header][Entry x entryCount, sorted by idHash][string table][data blobs]
+// Blobs are 16-byte aligned so mapped PCM can be handed to the mixer as-is.
+namespace pack_format {
+    inline constexpr std::uint32_t Magic = 0x4B504741; // "AGPK"
+    inline constexpr std::uint16_t Version = 1;
+
+    // Sounds are converted to the mixer's format at pack time
+    inline constexpr int SampleRate = 44100;
+    inline constexpr int Channels = 2;  // signed 16-bit interleaved
+
+    enum class AssetKind : std::uint16_t {
+        Shape = 1, // width*height chars, row-major, no separators
+        Sound = 2  // raw PCM frames
+    };
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t reserved;
+        std::uint32_t entryCount;
+        std::uint32_t stringTableOffset;
+        std::uint64_t fileSize;
+    };
+
+    struct Entry {
+        std::uint64_t idHash;     // hashId() of the id, for binary search
+        std::uint32_t nameOffset; // into the string table
+        std::uint32_t nameLength;
+        std::uint16_t kind;       // AssetKind
+        std::uint16_t width;      // shapes: columns, sounds: channels
+        std::uint32_t height;     // shapes: rows, sounds: sample rate
+        std::uint64_t dataOffset;
+        std::uint64_t dataSize;
+    };
+}
+
+// Zero-copy view of a packed shape (pixels point into the mapping)
+struct ShapeView {
+    std::string_view id;
+    std::string_view pixels;
+    int width;
+    int height;
+};
+
+// Zero-copy view of packed PCM (data points into the mapping)
+struct PcmView {
+    std::string_view id;
+    const std::uint8_t* data;
+    std::size_t size;
+    int sampleRate;
+    int channels;
+};
+
+// Read-only, memory-mapped asset pack
+// Opening only maps the file and reads the entry table; pages of assets are
+// faulted in on first use, so startup time and resident memory do not grow
+// with the number of assets. Views stay valid for the pack's lifetime.
+class AssetPack {
+public:
+    explicit AssetPack(const std::string& path);
+    ~AssetPack(); // munmap
+
+    // Non-copyable, movable (owns the mapping)
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+    AssetPack(AssetPack&& other) noexcept;
+    AssetPack& operator=(AssetPack&& other) noexcept;
+
+    bool isValid() const;
+    const std::string& path() const noexcept;
+
+    // Lookup by id (binary search on the hashed entry table)
+    const ShapeView* findShape(std::string_view id) const;
+    const PcmView* findSound(std::string_view id) const;
+
+    const std::vector<ShapeView>& shapes() const noexcept;
+    const std::vector<PcmView>& sounds() const noexcept;
+
+private:
+    bool parse();
+
+    std::string path_;
+    const std::uint8_t* base_{nullptr};
+    std::size_t size_{0};
+    std::vector<ShapeView> shapes_; // sorted by id hash
+    std::vector<PcmView> sounds_;   // sorted by id hash
+    std::vector<std::uint64_t> shapeHashes_;
+    std::vector<std::uint64_t> soundHashes_;
+};
+
+// Builds asset packs (used by the asset_packer tool)
+class AssetPackWriter {
+public:
+    void addShape(std::string id, const std::vector<std::string>& rows);
+
+    // Text file, one row per line (rows are padded to the widest line)
+    bool addShapeFile(std::string id, const std::string& path);
+
+    // PCM WAV file, converted to pack_format::SampleRate / Channels
+    bool addWavFile(std::string id, const std::string& path);
+
+    bool write(const std::string& path) const;
+
+    std::size_t assetCount() const noexcept;
+
+private:
+    struct PendingAsset {
+        std::string id;
+        pack_format::AssetKind kind;
+        int width;
+        int height;
+        std::vector<std::uint8_t> data;
+    };
+
+    std::vector<PendingAsset> assets_;
+};
+
+}
@@ -0,0 +1,62 @@
+module;
+#include <sys/inotify.h>
+
+export module resources.watcher;
+
+import <atomic>;
+import <functional>;
+import <mutex>;
+import <string>;
+import <thread>;
+import <vector>;
+
+export namespace age {
+
+// Called on the watcher thread with the full path of a changed file
+using AssetChangedCallback = std::function<void(const std::string& path)>;
+
+// Watches asset directories with inotify on a background thread
+// A file is reported once it has been fully written (IN_CLOSE_WRITE) or
+// moved into place (IN_MOVED_TO, what most editors do on save). Callbacks
+// run on the watcher thread, so they can do slow work (reading, decoding)
+// without stalling the game loop; results must be handed back through a
+// thread-safe queue and applied at a tick boundary. The Engine owns one
+// watcher (one thread, one inotify fd) shared by every subsystem that
+// hot-reloads.
+class AssetWatcher {
+public:
+    AssetWatcher();
+    ~AssetWatcher(); // stops and joins the thread
+
+    // Non-copyable (owns a thread and an inotify fd)
+    AssetWatcher(const AssetWatcher&) = delete;
+    AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+    bool isValid() const;
+
+    // Watch a directory (non-recursive); returns a watch id, or -1 on failure
+    int watch(const std::string& directory, AssetChangedCallback onChanged);
+    // Stop reporting a watch; blocks until none of its callbacks is running,
+    // so owners call it before they are destroyed
+    void unwatch(int id);
+
+private:
+    struct Watch {
+        int id;
+        int descriptor; // inotify wd (shared by watches of the same directory)
+        std::string directory;
+        AssetChangedCallback onChanged;
+    };
+
+    void run();
+
+    int inotifyFd_{-1};
+    int wakePipe_[2]{-1, -1}; // lets the destructor interrupt poll()
+    std::atomic<bool> running_{false};
+    std::mutex watchesMutex_;  // watch() may race with the watcher thread
+    std::vector<Watch> watches_;
+    int nextId_{0};
+    std::thread thread_;
+};
+
+}
@@ -0,0 +1,200 @@
+export module behavior;
+
+import <array>;
+import <coroutine>;
+import <cstddef>;
+import <cstdint>;
+import <functional>;
+import <memory>;
+import <string>;
+import <vector>;
+
+import events.event;
+import events.manager;
+
+export namespace age {
+
+class BehaviorScheduler;
+
+// Recycling allocator for coroutine frames
+// Frames are carved from slabs and returned to per-size-class free lists,
+// so spawning and finishing thousands of behaviors stops touching the heap
+// after warm-up. Each block is prefixed with its owning pool, so frames can
+// be freed without any context; oversized frames fall back to the heap.
+class BehaviorFramePool {
+public:
+    explicit BehaviorFramePool(std::size_t slabBytes = 64 * 1024);
+    ~BehaviorFramePool();
+
+    // Non-copyable, non-movable (live frames point back at the pool)
+    BehaviorFramePool(const BehaviorFramePool&) = delete;
+    BehaviorFramePool& operator=(const BehaviorFramePool&) = delete;
+
+    void* allocate(std::size_t bytes);
+    static void deallocate(void* frame, std::size_t bytes) noexcept;
+
+    std::size_t liveFrames() const noexcept;
+    std::size_t slabCount() const noexcept;
+
+private:
+    static constexpr std::size_t Granularity = 64;
+    static constexpr std::size_t SizeClasses = 16; // pooled up to 1 KiB
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void release(void* block, std::size_t sizeClass) noexcept;
+
+    std::array<FreeBlock*, SizeClasses> freeLists_{};
+    std::vector<std::unique_ptr<std::byte[]>> slabs_;
+    std::size_t slabBytes_;
+    std::size_t slabUsed_;
+    std::size_t live_{0};
+};
+
+// Coroutine return type for entity and engine behaviors
+// Write behaviors as coroutines that take the scheduler as their first
+// parameter (after the object, for member functions) so their frames come
+// from the scheduler's pool, e.g.
+//   Behavior march(BehaviorScheduler& s, Entity& e) {
+//       for (;;) { co_await waitTicks(30); e.move(1, 0); }
+//   }
+// A Behavior starts suspended and does nothing until spawned.
+class Behavior {
+public:
+    struct promise_type {
+        BehaviorScheduler* scheduler{nullptr};
+        int ownerId{-1};
+        const Event* event{nullptr}; // event that resumed the last event<> await
+
+        Behavior get_return_object() noexcept;
+        std::suspend_always initial_suspend() const noexcept;
+        std::suspend_always final_suspend() const noexcept;
+        void return_void() const noexcept;
+        void unhandled_exception() const noexcept; // terminates
+
+        template<typename... Args>
+        static void* operator new(std::size_t bytes, BehaviorScheduler& scheduler, Args&...);
+        template<typename Self, typename... Args>
+        static void* operator new(std::size_t bytes, Self&, BehaviorScheduler& scheduler, Args&...);
+        static void* operator new(std::size_t bytes); // no scheduler in scope: heap
+        static void operator delete(void* frame, std::size_t bytes) noexcept;
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Behavior() = default;
+    explicit Behavior(Handle handle) noexcept;
+    ~Behavior();
+
+    // Move-only (owns the coroutine frame until spawned)
+    Behavior(const Behavior&) = delete;
+    Behavior& operator=(const Behavior&) = delete;
+    Behavior(Behavior&& other) noexcept;
+    Behavior& operator=(Behavior&& other) noexcept;
+
+    bool valid() const noexcept;
+    bool done() const noexcept;
+
+    // Hand the frame over (used by BehaviorScheduler::spawn)
+    Handle release() noexcept;
+
+private:
+    Handle handle_{};
+};
+
+// co_await waitTicks(n): resume n ticks from now (0 = next tick)
+struct WaitTicks {
+    int ticks;
+
+    bool await_ready() const noexcept;
+    void await_suspend(Behavior::Handle handle) const;
+    void await_resume() const noexcept;
+};
+
+WaitTicks waitTicks(int ticks) noexcept;
+
+// co_await event<CollisionEvent>(): resume on the next event of that type
+// (and matching the filter, if given); the returned reference is only valid
+// until the behavior suspends again
+template<typename E>
+struct EventAwait {
+    std::function<bool(const E&)> filter;
+
+    bool await_ready() const noexcept;
+    void await_suspend(Behavior::Handle handle) const;
+    const E& await_resume() const noexcept;
+
+private:
+    mutable Behavior::Handle handle_{};
+};
+
+template<typename E>
+EventAwait<E> event(std::function<bool(const E&)> filter = {});
+
+// Resumes behaviors only when they are due
+// Sleeping behaviors sit in a min-heap keyed by wake tick, so a tick costs
+// nothing for behaviors that are not waking on it. Behaviors waiting on an
+// event are parked per event type behind one EventManager subscription and
+// resumed as the event is dispatched.
+class BehaviorScheduler {
+public:
+    explicit BehaviorScheduler(EventManager& events);
+    ~BehaviorScheduler(); // destroys every live frame and unsubscribes
+
+    // Non-copyable, non-movable (awaiters and subscriptions hold pointers)
+    BehaviorScheduler(const BehaviorScheduler&) = delete;
+    BehaviorScheduler& operator=(const BehaviorScheduler&) = delete;
+
+    // Start a behavior; it runs up to its first co_await immediately
+    // ownerId ties it to an entity so cancelOwner() can stop it
+    void spawn(Behavior behavior, int ownerId = -1);
+    void cancelOwner(int ownerId);
+    void cancelAll();
+
+    // Advance one tick and resume every behavior due on it
+    void update();
+
+    long long currentTick() const noexcept;
+    std::size_t liveCount() const noexcept;
+    std::size_t sleepingCount() const noexcept;
+    std::size_t waitingCount() const noexcept;
+    BehaviorFramePool& framePool() noexcept;
+
+    // Called by awaiters
+    void sleepUntil(Behavior::Handle handle, long long tick);
+    void waitFor(Behavior::Handle handle, const char* eventType, std::function<bool(const Event&)> filter);
+
+private:
+    struct Sleeper {
+        long long due;
+        std::uint64_t seq; // keeps FIFO order among equal wake ticks
+        Behavior::Handle handle;
+    };
+
+    struct Waiter {
+        Behavior::Handle handle;
+        std::function<bool(const Event&)> filter;
+    };
+
+    struct WaitList {
+        std::string eventType;
+        int subscriptionId;
+        std::vector<Waiter> waiters;
+    };
+
+    void resume(Behavior::Handle handle);
+    void onEvent(std::size_t list, const Event& event);
+    void destroy(Behavior::Handle handle);
+
+    EventManager& events_;
+    BehaviorFramePool pool_;
+    std::vector<Behavior::Handle> live_;
+    std::vector<Sleeper> sleepers_;  // min-heap on (due, seq)
+    std::vector<WaitList> waitLists_; // one per awaited event type
+    long long tick_{0};
+    std::uint64_t nextSeq_{0};
+};
+
+}
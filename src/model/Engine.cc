@@ -1,27 +1,67 @@
 export module engine;
 
+import <cstdint>;
 import <functional>;
 import <memory>;
+import <random>;
 import <string>;
 import <vector>;
 
 import audio.sound;
+import behavior;
 import controller;
+import controller.async;
+import controller.replay;
 import core.clock;
 import core.input_event;
+import core.memory;
+import core.snapshot;
+import engine.hud;
 import events.event;
 import events.manager;
 import model;
+import particles;
 import render.drawable;
+import render.layer;
 import resources.manager;
+import resources.watcher;
 import view;
 import world;
 
 export namespace age {
 
 // Callback type for game-specific per-tick logic
-// Called each frame with delta time and current input
-using GameUpdateCallback = std::function<void(float dt, const InputEvent& input)>;
+// Called each frame with delta time and every key drained this tick
+using GameUpdateCallback = std::function<void(float dt, const InputState& input)>;
+
+// Session setup parsed from the command line and shared by all games
+struct SessionOptions {
+    std::string recordPath;  // write an input log here (empty = off)
+    std::string replayPath;  // feed this log back instead of the keyboard
+    bool headless{false};    // no views and no frame pacing (replay at max speed)
+    bool hotReload{false};   // load assets from files and reload them when edited
+    bool asyncInput{false};  // read keys on a dedicated thread (AsyncController)
+    std::string audioCapturePath; // headless: write the offline audio mix here
+
+    // Unattended runs (bots, fuzzing, SimulationFarm)
+    bool fixedSeed{false};           // use seed instead of a random one (replay overrides)
+    std::uint32_t seed{0};
+    int maxTicks{0};                 // stop after this many simulation ticks (0 = no limit)
+    Controller* controller{nullptr}; // headless input source; not owned (nullptr = no input)
+};
+
+// Outcome of one session, returned by the game entry points
+struct SessionResult {
+    std::uint32_t seed{0};
+    int ticks{0};
+    int score{0};
+    int level{0};
+    bool won{false};
+    bool gameOver{false};
+    std::uint64_t stateHash{0};
+    long long wallNs{0};
+    long long firstFrameNs{0}; // timeToFirstFrameNs() of the session
+};
 
 // Engine is a concrete Model (MVC)
 // Owns and coordinates all game subsystems
@@ -36,6 +76,8 @@ public:
 
     std::vector<std::string> collectStatus() override;
 
+    std::vector<const RenderLayer*> collectRenderLayers() override;
+
     // Main game loop
     void run() override;
 
@@ -45,12 +87,32 @@ public:
     bool isWon() const noexcept;
     int level() const noexcept;
     int score() const noexcept;
+    const InputState& input() const noexcept;
+    // Ticks without a repeat before a held key counts as released
+    void setInputReleaseTicks(int ticks) noexcept;
+    // Read-to-drain key latency when the controller is an AsyncController
+    // (nullptr otherwise); also shown on the performance HUD
+    const InputLatencyStats* inputLatency() const noexcept;
 
     // Getters for subsystems
+    Clock& clock() noexcept;
     World& world() noexcept;
     const World& world() const noexcept;
     EventManager& events() noexcept;
+    // Coroutine behaviors, resumed each step before the game callback;
+    // behaviors spawned with an entity id are cancelled when it is removed
+    BehaviorScheduler& behaviors() noexcept;
     ResourceManager& resources() noexcept;
+    ParticleSystem& particles() noexcept;
+
+    // Per-subsystem memory accounting (World, EventManager, ResourceManager,
+    // SoundSystem, views). Each subsystem allocates from its own tracking
+    // resource; views and the sound system are attached when added/run.
+    // The overlay appends live/peak bytes and allocations per tick to the
+    // status lines, flagging subsystems over their per-tick budget.
+    MemoryTracker& memory() noexcept;
+    void setMemoryOverlay(bool enabled) noexcept;
+    bool memoryOverlay() const noexcept;
     SoundSystem& sound() noexcept;
 
     // Setters for game state
@@ -60,12 +122,65 @@ public:
     void setScore(int s) noexcept;
     void addScore(int delta) noexcept;
     void setRefreshRate(int rate);
+
+    // Fixed-timestep simulation, decoupled from the render rate
+    // Each frame the elapsed time is accumulated and World::update runs in
+    // fixed steps of 1/simulationRate, up to maxCatchUpSteps per frame; time
+    // beyond that is dropped so a long stall slows the game briefly instead of
+    // spiralling. Frames render entities interpolated between their previous
+    // and current step by interpolationAlpha(). Input is drained once per
+    // frame; every step of the frame sees the same held keys, but pressed and
+    // released edges (and raw events) only reach the first step. The
+    // recorder logs input per step, so replays see the same split.
+    void setSimulationRate(int rate);
+    int simulationRate() const noexcept;
+    void setMaxCatchUpSteps(int steps);
+    int maxCatchUpSteps() const noexcept;
+    void setInterpolation(bool enabled) noexcept;
+    float interpolationAlpha() const noexcept;
     void setSoundSystem(std::unique_ptr<SoundSystem> sound);
 
+    // The single inotify thread shared by every hot-reloading subsystem
+    // (ResourceManager, SDLSoundSystem); started on first use
+    AssetWatcher& assetWatcher();
+
     // Set game-specific per-tick update callback
     // This is called each frame before world.update()
     void setGameUpdate(GameUpdateCallback callback);
 
+    // Recording / replay / headless setup; call before seeding game RNGs
+    // Replay replaces the controller and takes the seed from the log
+    void startSession(const SessionOptions& options);
+    bool isHeadless() const noexcept;
+    SessionResult sessionResult() const;
+    int divergedTick() const noexcept; // first tick a replay diverged, -1 if none
+
+    // Performance HUD (frame/tick sparklines, entities, collision pairs,
+    // events per tick, voices) in a corner of the game window; run() toggles
+    // it when the HUD key is pressed. Hidden, it is neither sampled nor drawn.
+    PerfHud& hud() noexcept;
+    void setHudKey(int key) noexcept; // default '`'
+
+    // Quick-save / rewind / rollback: World state plus tick, score, level,
+    // game flags and RNG state. The writer is reused, so snapshotting every
+    // tick does not allocate once warm. Coroutine behaviors are not captured.
+    void saveSnapshot(Snapshot& out);
+    // Game-owned shapes are not in the ResourceManager, so games pass
+    // resolveShape to map their sprite ids back (empty = ResourceManager only)
+    bool restoreSnapshot(const Snapshot& in, const ShapeResolver& resolveShape = {});
+    // Called after a successful restore so the game can relink what it holds
+    // into the World (player pointer, counters...)
+    void setOnSnapshotRestored(std::function<void()> callback);
+
+    // Startup cost: time from Engine construction to the first rendered frame
+    // Also handed to the HUD once known and copied into sessionResult()
+    long long timeToFirstFrameNs() const noexcept;
+
+    // Session RNG; games must draw randomness from this seed for replays to match
+    std::uint32_t seed() const noexcept;
+    void setSeed(std::uint32_t seed);
+    std::mt19937& rng() noexcept;
+
 private:
     // Game state
     bool quit_{false};
@@ -75,16 +190,50 @@ private:
     int level_{1};
     int score_{0};
     int refreshRate_{60};
+    int simulationRate_{60};
+    int maxCatchUpSteps_{5};
+    bool interpolate_{true};
+    double accumulator_{0.0};
+    float alpha_{1.0f};
+    bool headless_{false};
+    int maxTicks_{0};
+    long long createdNs_{0};
+    long long firstFrameNs_{0};
+    InputState input_;
+    std::uint32_t seed_{0};
+    std::mt19937 rng_;
+
+    PerfHud hud_;
+    int hudKey_{'`'};
+    long long lastTickNs_{0}; // simulation time of the current frame (HUD only)
+
+    // Declared first so it outlives every subsystem allocating from it
+    MemoryTracker memory_;
+    bool memoryOverlay_{false};
 
     // Subsystems (owned by Engine)
+    // The watcher outlives the subsystems that unwatch it when destroyed
+    std::unique_ptr<AssetWatcher> watcher_;
     Clock clock_;
-    World world_;
-    EventManager events_;
+    World world_{78, 20, World::BorderMode::Solid, memory_.share(MemoryTracker::Subsystem::World)};
+    EventManager events_{&memory_.resource(MemoryTracker::Subsystem::Events)};
+    BehaviorScheduler behaviors_{events_};
     ResourceManager resources_;
+    ParticleSystem particles_;
     std::unique_ptr<SoundSystem> sound_;
 
+    // Session recording / replay (optional)
+    std::unique_ptr<InputRecorder> recorder_;
+    std::unique_ptr<ReplayController> replay_;
+
+    SnapshotWriter snapshotWriter_;
+    std::function<void()> onSnapshotRestored_;
+
     // Game-specific callback (called each tick)
     GameUpdateCallback gameUpdate_;
+
+    // One fixed simulation step (behaviors, game callback, world, particles, events)
+    void step(float dt, const InputState& input);
 };
 
 }
@@ -1,5 +1,6 @@
 export module entity;
 
+import <cstdint>;
 import <functional>;
 import <memory>;
 import <string>;
@@ -8,7 +9,9 @@ import <vector>;
 import core.hitbox;
 import core.input_event;
 import core.position;
+import core.snapshot;
 import entity.animation;
+import nav.flowfield;
 import render.drawable;
 import render.shape;
 
@@ -26,11 +29,29 @@ class Entity;
 // Collision callback type
 using CollisionCallback = std::function<void(Entity& self, Entity& other)>;
 
+// Identifies a movement component in snapshots
+enum class MovementKind : std::uint8_t {
+    Custom,          // game-defined; not restored (re-add in World's restore callback)
+    Straight,
+    Cycle,
+    Gravity,
+    PlayerControlled,
+    FlowField        // restored without a field; World re-binds it on restore
+};
+
 // Abstract base for movement behaviors
 class MovementComponent {
 public:
     virtual ~MovementComponent() = default;
-    virtual void apply(Entity& entity, const InputEvent& input) = 0;
+    virtual void apply(Entity& entity, const InputState& input) = 0;
+
+    // Snapshot support: save/load write and read the full component state
+    virtual MovementKind kind() const noexcept;
+    virtual void save(SnapshotWriter& out) const;
+    virtual bool load(SnapshotReader& in);
+
+    // Default-constructed component of a built-in kind, ready for load()
+    static std::unique_ptr<MovementComponent> create(MovementKind kind);
 };
 
 // Constant velocity movement (velocity in pixels per tick)
@@ -38,7 +59,10 @@ class StraightMovement final : public MovementComponent {
 public:
     StraightMovement(float vx, float vy);
 
-    void apply(Entity& entity, const InputEvent& input) override;
+    void apply(Entity& entity, const InputState& input) override;
+    MovementKind kind() const noexcept override;
+    void save(SnapshotWriter& out) const override;
+    bool load(SnapshotReader& in) override;
 
     float velocityX() const;
     float velocityY() const;
@@ -57,7 +81,10 @@ public:
     // interval is in ticks (e.g. 5 = change position every 5 ticks)
     CycleMovement(std::vector<Position> offsets, int intervalTicks);
 
-    void apply(Entity& entity, const InputEvent& input) override;
+    void apply(Entity& entity, const InputState& input) override;
+    MovementKind kind() const noexcept override;
+    void save(SnapshotWriter& out) const override;
+    bool load(SnapshotReader& in) override;
     
     void reset();
 
@@ -73,7 +100,10 @@ class GravityMovement final : public MovementComponent {
 public:
     explicit GravityMovement(float fallSpeed);
 
-    void apply(Entity& entity, const InputEvent& input) override;
+    void apply(Entity& entity, const InputState& input) override;
+    MovementKind kind() const noexcept override;
+    void save(SnapshotWriter& out) const override;
+    bool load(SnapshotReader& in) override;
     
     float fallSpeed() const;
     void setFallSpeed(float fallSpeed);
@@ -83,12 +113,15 @@ private:
     float accumulator_;
 };
 
-// Keyboard-controlled movement
+// Keyboard-controlled movement (moves every tick a bound key is held)
 class PlayerControlledMovement final : public MovementComponent {
 public:
     PlayerControlledMovement(float speed, int left, int right, int up, int down);
 
-    void apply(Entity& entity, const InputEvent& input) override;
+    void apply(Entity& entity, const InputState& input) override;
+    MovementKind kind() const noexcept override;
+    void save(SnapshotWriter& out) const override;
+    bool load(SnapshotReader& in) override;
     
     void setMoveSpeed(float speed);
 
@@ -100,6 +133,36 @@ private:
     int keyDown_;
 };
 
+// Follows a shared FlowField toward its target (owned by World)
+// Each move is one cell lookup, so a swarm costs the same per entity
+// regardless of how far the target is or how many entities follow it.
+class FlowFieldMovement final : public MovementComponent {
+public:
+    // fieldId is the World index of field (see World::followFlowField(),
+    // which fills both); it is what snapshots save, so restore re-binds to
+    // the same field. speed in cells per tick (fractions accumulate); a
+    // null field (detached by World::clearFlowFields()) makes apply() a no-op
+    FlowFieldMovement(std::uint16_t fieldId, const FlowField* field, float speed);
+
+    void apply(Entity& entity, const InputState& input) override;
+    MovementKind kind() const noexcept override;
+    void save(SnapshotWriter& out) const override;
+    bool load(SnapshotReader& in) override;
+
+    // Id and pointer always change together, so a save can't record a stale id
+    void setField(std::uint16_t fieldId, const FlowField* field);
+    void detach() noexcept; // field = nullptr; saved unbound, so restore won't re-bind
+    const FlowField* field() const;
+    std::uint16_t fieldId() const; // World's field index, for snapshot re-binding
+    void setSpeed(float speed);
+
+private:
+    const FlowField* field_;
+    std::uint16_t fieldId_;
+    float speed_;
+    float accumulator_;
+};
+
 // Game object
 class Entity {
 public:
@@ -113,13 +176,15 @@ public:
     Entity& operator=(Entity&&) noexcept = default;
 
     // Core update method - applies movements and advances animation
-    void update(const InputEvent& input);
+    void update(const InputState& input);
     
     // Called by World when collision detected
     void onCollision(Entity& other);
 
     // Rendering
     Drawable toDrawable() const;
+    // Position blended between prevPosition (alpha 0) and position (alpha 1)
+    Drawable toDrawable(float alpha) const;
 
     // Lifecycle
     bool isAlive() const;
@@ -137,20 +202,36 @@ public:
     int ageTicks() const;
     int maxAgeTicks() const;
     bool clampToBorders() const;
+    bool continuousCollision() const;
+    // World's spatial grid proxy (0xFFFFFFFF while not in a World)
+    std::uint32_t spatialProxy() const;
+    void setSpatialProxy(std::uint32_t proxy);
     Animation* animation();
     const Animation* animation() const;
+    AnimationCursor& animationCursor();
+    const AnimationCursor& animationCursor() const;
 
     // Setters
     void setPosition(Position pos);
     void setPosition(int x, int y);
     void move(int dx, int dy);
+    // Snap prevPosition to position so a teleport is not interpolated
+    void resetInterpolation();
     void setHitbox(Hitbox hb);
     void setHeight(int h);
     void setSolidity(Solidity s);
     void setBaseShape(const Shape* shape);
     void setMaxAgeTicks(int max);
     void setClampToBorders(bool clamp);
+    // Sweep the hitbox from prevPosition to position when testing collisions,
+    // so movers faster than a cell per tick can't tunnel through thin targets
+    // (off by default; only fast projectiles need it)
+    void setContinuousCollision(bool enabled);
     void setAnimation(std::unique_ptr<Animation> anim);
+    // Play a shared clip; advanced by World's batched animation pass
+    void setAnimation(ClipId clip, bool synchronized = false, int phase = 0);
+    // Shape and offset to render, written by the animation pass
+    void setAnimationFrame(const Frame& frame);
     void setOnCollision(CollisionCallback cb);
 
     // Movement component management
@@ -158,6 +239,13 @@ public:
     void clearMovements();
     template<typename T> T* getMovement();
 
+    // Snapshot support (the collision callback is not saved)
+    // Shapes are written by sprite id and resolved through shapes, indexed by
+    // snapshot string index (nullptr for strings that are not shapes). The
+    // continuous-collision flag is saved with the other collision settings.
+    void save(SnapshotWriter& out) const;
+    bool restore(SnapshotReader& in, const std::vector<const Shape*>& shapes);
+
 private:
     int id_;
     std::string tag_;
@@ -171,11 +259,17 @@ private:
     const Shape* baseShape_;
     std::vector<std::unique_ptr<MovementComponent>> movements_;
     std::unique_ptr<Animation> animation_;
+    AnimationCursor cursor_;
+    const Shape* frameShape_{nullptr}; // current clip frame (nullptr = baseShape_)
+    int frameOffsetX_{0};
+    int frameOffsetY_{0};
     CollisionCallback onCollisionCallback_;
 
     int ageTicks_;
     int maxAgeTicks_;
     bool clampToBorders_;
+    bool continuousCollision_{false};
+    std::uint32_t spatialProxy_{0xFFFFFFFFu};
 };
 
 }
@@ -0,0 +1,76 @@
+export module nav.flowfield;
+
+import <cstddef>;
+import <cstdint>;
+import <vector>;
+
+import core.position;
+
+export namespace age {
+
+// Step from a cell toward the field's target (each component in -1..1)
+struct FlowStep {
+    std::int8_t dx{0};
+    std::int8_t dy{0};
+};
+
+// Shared direction field over the world grid toward one target cell
+// A breadth-first search runs outward from the target (8-connected, no
+// corner cutting past blocked cells) and each cell stores the step to its
+// neighbour with the smallest distance, so followers only read one cell per
+// move. Rebuilds happen only when the target enters a different cell or the
+// obstacles change, and can be spread over several ticks with a cell
+// budget; followers keep using the previous field until the new one is done.
+class FlowField {
+public:
+    static constexpr std::uint16_t Unreachable = 0xFFFF;
+
+    FlowField(int width, int height);
+
+    // Target cell (no rebuild if it stays in the same cell)
+    void setTarget(Position target);
+    const Position& target() const noexcept;
+
+    // Obstacle grid (world cells); any change schedules a rebuild
+    void setBlocked(int x, int y, bool blocked);
+    void clearBlocked();
+    bool isBlocked(int x, int y) const noexcept;
+
+    // Advance a pending rebuild by at most cellBudget cells (0 = finish now)
+    // Returns true when the published field matches the current target and obstacles
+    bool update(int cellBudget = 0);
+    bool isCurrent() const noexcept;
+    std::uint64_t generation() const noexcept; // bumped each time a rebuild completes
+
+    // Queries on the published field; {0, 0} at the target, outside the
+    // grid and where the target is unreachable
+    FlowStep stepAt(int x, int y) const noexcept;
+    std::uint16_t distanceAt(int x, int y) const noexcept;
+
+    int width() const noexcept;
+    int height() const noexcept;
+
+private:
+    void beginRebuild();
+    void publish();
+
+    int width_;
+    int height_;
+    Position target_;
+    bool dirty_{true};     // inputs changed since the last published field
+    bool building_{false};
+    std::uint64_t generation_{0};
+
+    std::vector<std::uint8_t> blocked_;
+
+    // Published field (read by followers)
+    std::vector<std::uint16_t> distance_;
+    std::vector<FlowStep> steps_;
+
+    // In-progress rebuild (BFS queue of cell indices, reused between rebuilds)
+    std::vector<std::uint16_t> buildDistance_;
+    std::vector<std::int32_t> frontier_;
+    std::size_t frontierHead_{0};
+};
+
+}
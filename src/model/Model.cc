@@ -5,6 +5,7 @@ import <vector>;
 
 import controller;
 import render.drawable;
+import render.layer;
 import view;
 
 export namespace age {
@@ -32,6 +33,9 @@ public:
     virtual std::vector<std::string> collectStatus() = 0;
     virtual void run() = 0;
 
+    // Layers rendered straight into the view buffer (none by default)
+    virtual std::vector<const RenderLayer*> collectRenderLayers();
+
 protected:
     std::vector<View*> views_;
     Controller* controller_{nullptr};
@@ -0,0 +1,97 @@
+export module particles;
+
+import <cstddef>;
+import <cstdint>;
+import <random>;
+import <string>;
+import <vector>;
+
+import render.layer;
+
+export namespace age {
+
+// Parameters for spawning particles (positions in cells, velocities in cells per tick)
+struct ParticleSpawn {
+    float x{0.0f};
+    float y{0.0f};
+    float speedMin{0.2f};
+    float speedMax{1.0f};
+    float angleMin{0.0f};        // radians, 0 = right, pi/2 = down
+    float angleMax{6.2831853f};
+    float gravity{0.0f};         // added to vy every tick
+    int lifeMin{10};             // ticks
+    int lifeMax{20};
+    std::string glyphs{"*"};     // ramp from newborn to dying (e.g. "@*+.")
+};
+
+using EmitterId = int;
+
+// Particle pool kept entirely outside the entity model
+// Particles are plain structure-of-arrays data: no Entity, no movement
+// components, never seen by World::handleCollisions(). The integrate pass
+// is a branch-free loop over contiguous floats so it auto-vectorises, and
+// dead particles are swap-removed so live ones stay densely packed.
+class ParticleSystem final : public RenderLayer {
+public:
+    explicit ParticleSystem(std::size_t capacity = 65536, int z = 10);
+
+    // One-shot spawn (explosions); excess beyond capacity is dropped
+    void burst(const ParticleSpawn& spawn, int count);
+
+    // Continuous emitters (trails), rate may be fractional
+    EmitterId addEmitter(const ParticleSpawn& spawn, float particlesPerTick);
+    void moveEmitter(EmitterId id, float x, float y);
+    void removeEmitter(EmitterId id);
+    void clearEmitters();
+
+    // Advance one tick: run emitters, integrate, age and compact
+    void update();
+
+    // Kill all live particles (emitters are kept)
+    void clear();
+
+    std::size_t liveCount() const noexcept;
+    std::size_t capacity() const noexcept;
+
+    void setSeed(std::uint32_t seed);
+
+    // RenderLayer interface, one glyph per live particle
+    int z() const noexcept override;
+    void setZ(int z) noexcept;
+    void renderInto(std::vector<std::string>& buffer) const override;
+
+private:
+    struct Emitter {
+        EmitterId id;
+        ParticleSpawn spawn;
+        std::uint16_t ramp;
+        float rate;
+        float accumulator;
+    };
+
+    std::uint16_t internRamp(const std::string& glyphs);
+    void spawn(const ParticleSpawn& spawn, std::uint16_t ramp, int count);
+    void integrate() noexcept;
+    void compact() noexcept;
+
+    std::size_t capacity_;
+    std::size_t live_{0};
+    int z_;
+
+    // Structure-of-arrays pool (each array sized to capacity_)
+    std::vector<float> posX_;
+    std::vector<float> posY_;
+    std::vector<float> velX_;
+    std::vector<float> velY_;
+    std::vector<float> gravity_;
+    std::vector<std::int32_t> life_;     // remaining ticks
+    std::vector<std::int32_t> maxLife_;
+    std::vector<std::uint16_t> ramp_;    // index into ramps_
+
+    std::vector<std::string> ramps_;
+    std::vector<Emitter> emitters_;
+    EmitterId nextEmitterId_{1};
+    std::mt19937 rng_;
+};
+
+}
@@ -0,0 +1,70 @@
+export module engine.hud;
+
+import <array>;
+import <cstdint>;
+import <string>;
+import <vector>;
+
+import render.layer;
+
+export namespace age {
+
+// One frame's worth of engine counters
+struct PerfSample {
+    long long frameNs{0};   // wall time of the whole frame, including pacing
+    long long tickNs{0};    // simulation steps only
+    int steps{0};           // fixed steps run this frame
+    int entities{0};
+    int collisionTests{0};  // narrow-phase hitbox tests
+    int collisionPairs{0};  // pairs that actually collided
+    int events{0};          // events dispatched
+    int voices{0};          // sound voices playing
+    long long inputLatencyNs{-1};    // mean key read-to-drain latency (-1 = not measured)
+    long long inputLatencyMaxNs{-1};
+};
+
+// Performance overlay drawn in a corner of the game window
+// Samples go into a fixed ring, so nothing is allocated per frame; the
+// Engine only samples and renders it while visible, so a hidden HUD costs a
+// single branch per frame.
+class PerfHud final : public RenderLayer {
+public:
+    enum class Corner { TopLeft, TopRight, BottomLeft, BottomRight };
+
+    // Sparkline width in frames
+    static constexpr int History = 32;
+
+    explicit PerfHud(int z = 1000);
+
+    void setVisible(bool visible) noexcept;
+    bool isVisible() const noexcept;
+    void toggle() noexcept;
+
+    void setCorner(Corner corner) noexcept;
+
+    void record(const PerfSample& sample) noexcept;
+    void reset() noexcept;
+
+    // Construction-to-first-frame time, shown as a fixed line (-1 = unknown)
+    void setStartupNs(long long ns) noexcept;
+    const PerfSample& latest() const noexcept;
+
+    // Same information as text (for views without layer support)
+    void appendStatusLines(std::vector<std::string>& out) const;
+
+    // RenderLayer interface: sparklines scaled to the worst frame in the
+    // window, glyph ramp " .:-=+*#"
+    int z() const noexcept override;
+    void renderInto(std::vector<std::string>& buffer) const override;
+
+private:
+    std::array<PerfSample, History> samples_{};
+    int head_{0};   // next slot to write
+    int count_{0};
+    long long startupNs_{-1};
+    bool visible_{false};
+    Corner corner_{Corner::TopRight};
+    int z_;
+};
+
+}
@@ -0,0 +1,87 @@
+export module resources.prefab;
+
+import <array>;
+import <cstdint>;
+import <memory>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+
+import core.hitbox;
+import core.position;
+import entity;
+import entity.animation;
+import render.shape;
+
+export namespace age {
+
+// Prefab / level file format (text, one directive per line, '#' comments)
+//   prefab <id>
+//     tag <tag>
+//     shape <shape id>
+//     hitbox <offsetX> <offsetY> <width> <height>   (default: shape bounds)
+//     height <z>
+//     solidity solid|trigger|ghost
+//     maxage <ticks>
+//     clamp on|off
+//     clip <clip id> [sync [phase]]
+//     move straight <vx> <vy>
+//     move gravity <fallSpeed>
+//     move cycle <intervalTicks> <dx>,<dy> ...
+//     move player <speed> <left> <right> <up> <down>
+//   end
+//   level <id>
+//     set <key> <int>
+//     place <prefab> <x> <y>
+//     grid <prefab> <x> <y> <cols> <rows> <dx> <dy>
+//   end
+// Files are parsed once by ResourceManager::loadPrefabFile(); ids, shapes
+// and clips are resolved at load time, so instantiation does no lookups.
+
+// Built-in movement component recorded in a prefab
+struct PrefabMovement {
+    MovementKind kind{MovementKind::Straight};
+    float x{0.0f};                  // straight vx, gravity fall speed, player speed
+    float y{0.0f};                  // straight vy
+    int intervalTicks{1};           // cycle
+    std::vector<Position> offsets;  // cycle
+    std::array<int, 4> keys{};      // player: left, right, up, down
+
+    std::unique_ptr<MovementComponent> instantiate() const;
+};
+
+// Compiled entity template: everything a chain of setSolidity/addMovement/
+// setAnimation calls would set up, applied in one pass per instance
+struct Prefab {
+    std::string id;
+    std::string tag;
+    const Shape* shape{nullptr};
+    Hitbox hitbox;
+    bool hasHitbox{false};
+    int height{0};
+    Solidity solidity{Solidity::Solid};
+    int maxAgeTicks{-1};
+    bool clampToBorders{true};
+    ClipId clip{InvalidClip};
+    bool syncClip{false};
+    int clipPhase{0};
+    std::vector<PrefabMovement> movements;
+};
+
+// Compiled level: grids are expanded into individual placements at load time
+struct LevelPlacement {
+    const Prefab* prefab;
+    Position position;
+};
+
+struct Level {
+    std::string id;
+    std::vector<LevelPlacement> placements;
+    std::unordered_map<std::string, int> properties; // "set" directives
+
+    int property(const std::string& key, int fallback = 0) const;
+    // Placements of one prefab tag (e.g. enemies left to clear)
+    std::size_t countTag(const std::string& tag) const;
+};
+
+}
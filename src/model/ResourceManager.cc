@@ -1,28 +1,119 @@
 export module resources.manager;
 
+import <cstddef>;
+import <cstdint>;
+import <deque>;
+import <functional>;
+import <array>;
 import <memory>;
+import <memory_resource>;
+import <mutex>;
 import <string>;
+import <string_view>;
+import <unordered_map>;
 import <vector>;
 
+import core.hash;
+import core.memory;
+import entity.animation;
 import render.shape;
+import resources.pack;
+import resources.prefab;
+import resources.watcher;
 
 export namespace age {
 
+// Block-allocated storage for shape pixels and row offsets
+// A shape's offsets and chars are stored back to back in one block, and
+// blocks are never reallocated, so views into them stay valid until they
+// are released or clear() runs. Released ranges are reused first-fit by
+// later stores, so reloading a shape over and over doesn't grow the arena.
+class ShapeArena {
+public:
+    explicit ShapeArena(std::size_t blockSize = 64 * 1024);
+
+    struct Allocation {
+        const char* data;
+        const std::uint32_t* rowOffsets; // rows.size() + 1 entries
+    };
+
+    Allocation store(const std::vector<std::string>& rows);
+    // Hand back a shape's storage (rows = its row count) for reuse
+    void release(const Allocation& allocation, std::size_t rows);
+    void clear();
+    std::size_t bytesUsed() const noexcept;
+
+    // Blocks allocated from now on come from resource (nullptr = default heap)
+    void setUpstream(std::pmr::memory_resource* resource) noexcept;
+
+private:
+    std::byte* allocate(std::size_t bytes, std::size_t align);
+
+    std::size_t blockSize_;
+    std::size_t blockUsed_{0};
+    std::size_t bytesUsed_{0};
+    struct Block {
+        std::byte* data;
+        std::size_t size;
+        std::pmr::memory_resource* resource;
+    };
+
+    struct FreeRange {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    std::pmr::memory_resource* upstream_{std::pmr::new_delete_resource()};
+    std::vector<Block> blocks_;
+    std::vector<FreeRange> freeRanges_; // released allocations, reused first-fit
+};
+
+// Orientation variants of a shape
+// Mirrors swap direction-sensitive glyphs ('/' and '\', '(' and ')', ...)
+// and rotations swap '-' and '|', so transformed ASCII art stays coherent.
+enum class ShapeTransform : std::uint8_t {
+    None,
+    MirrorH,    // flip left/right
+    MirrorV,    // flip top/bottom
+    Rotate90,   // clockwise
+    Rotate180,
+    Rotate270,
+    Count
+};
+
+inline constexpr std::size_t ShapeTransformCount = static_cast<std::size_t>(ShapeTransform::Count);
+
+// Variants are registered as "<id>|<transform>"; registered ids may not
+// contain the separator, so a variant name can never shadow a user shape
+inline constexpr char VariantSeparator = '|';
+
+// Resolves prefab shape ids the manager doesn't own (e.g. game-defined shapes)
+using PrefabShapeResolver = std::function<const Shape*(const std::string& id)>;
+
 // Centralized manager for game resources (shapes, sound clips, etc.)
 class ResourceManager {
 public:
     ResourceManager() = default;
-    ~ResourceManager() = default;
+    ~ResourceManager(); // unwatches its hot reload directories
+
+    // Non-copyable (the watcher calls back into this instance)
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
 
     // Register a shape and return a pointer to it
-    // The ResourceManager owns the shape memory
+    // The ResourceManager owns the shape memory; pixels go into the arena and
+    // the pointer stays valid until clear(). Returns nullptr if id contains
+    // VariantSeparator.
     const Shape* registerShape(std::string id, std::vector<std::string> pixels);
 
     // Get a shape by ID (returns nullptr if not found)
+    // IdKey overloads skip hashing the id on every call
     const Shape* getShape(const std::string& id) const;
+    const Shape* getShape(const IdKey& key) const;
 
     // Check if a shape exists
     bool hasShape(const std::string& id) const;
+    bool hasShape(const IdKey& key) const;
 
     // Get all registered shape IDs
     std::vector<std::string> getShapeIds() const;
@@ -33,8 +124,103 @@ public:
     // Get count of registered shapes
     size_t shapeCount() const;
 
+    // Register an immutable animation clip shared by any number of entities
+    // Clips live until clear(); ids are dense indices, so lookups are O(1)
+    ClipId registerClip(std::string id, std::vector<Frame> frames, bool looping = true);
+    const AnimationClip* getClip(ClipId clip) const;
+    ClipId findClip(const std::string& id) const;
+    size_t clipCount() const;
+
+    // Shape arena blocks and asset pack bookkeeping allocate from resource;
+    // mapped pack bytes are reported as external memory
+    void setMemoryTracking(TrackingResource* resource);
+
+    // Parse a prefab/level file (format in resources.prefab) into compiled
+    // templates. Shape ids are looked up here first, then through resolve;
+    // clip ids must already be registered. Returns false (and keeps nothing
+    // from the file) on any syntax error or unknown reference.
+    bool loadPrefabFile(const std::string& path, const PrefabShapeResolver& resolve = {});
+    const Prefab* getPrefab(const std::string& id) const;
+    const Level* getLevel(const std::string& id) const;
+    // Every loaded level, in the order the files declared them
+    std::vector<const Level*> levels() const;
+
+    // Get a transformed variant of a registered shape (nullptr if id is unknown)
+    // Built once on first request, then served from a cache keyed by id (not
+    // by address, so a freed and reused Shape can't hit a stale entry); the
+    // variant is owned by the manager and registered as "<id>|<transform>".
+    // Game-owned shapes must be registered before they can be transformed.
+    const Shape* getVariant(const std::string& id, ShapeTransform transform);
+    const Shape* getVariant(const IdKey& key, ShapeTransform transform);
+
+    // Override how a glyph is remapped by a transform (e.g. 'b' -> 'd' for MirrorH)
+    void setGlyphMapping(ShapeTransform transform, char from, char to);
+
+    // Map an asset pack and register each of its shapes as a zero-copy view
+    // Returns nullptr if the pack can't be opened; packs live as long as the manager
+    const AssetPack* loadPack(const std::string& path);
+
+    // Find packed PCM by sound ID across loaded packs (nullptr if not found)
+    const PcmView* getSound(const std::string& id) const;
+
+    // File-backed shapes: text files with one row per line, id = file name
+    // without extension (e.g. assets/shapes/space_invaders/enemy_a.txt)
+    const Shape* loadShapeFile(const std::string& path);
+    int loadShapeDirectory(const std::string& directory);
+
+    // Watch every directory passed to loadShapeDirectory() on the shared
+    // watcher (Engine::assetWatcher(), which must outlive the manager)
+    // Edited files are re-read on the watcher thread, never the game thread
+    bool enableHotReload(AssetWatcher& watcher);
+
+    // Swap in shapes reloaded since the last call (Engine calls this at a tick
+    // boundary). Shapes are updated in place, so const Shape* held by
+    // entities and animations stay valid, and their cached variants are
+    // rebuilt in place too; the old pixels go back to the arena for reuse.
+    // Returns the number swapped.
+    int applyReloads();
+
 private:
-    std::vector<std::unique_ptr<Shape>> shapes_;
+    // Open-addressing index from id hash to shape (linear probing,
+    // ids compared on hash match; grown at 50% load)
+    struct IndexSlot {
+        std::uint64_t hash;
+        const Shape* shape; // nullptr = empty slot
+    };
+
+    const Shape* find(std::string_view id, std::uint64_t hash) const;
+    void insertIndex(std::uint64_t hash, const Shape* shape);
+    void growIndex();
+
+    const Shape* buildVariant(const Shape& shape, ShapeTransform transform);
+    static std::vector<std::string> transformRows(const Shape& shape, ShapeTransform transform,
+                                                  const std::array<char, 128>& glyphMap);
+
+    std::deque<Shape> shapes_; // deque keeps element addresses stable
+    std::vector<IndexSlot> index_;
+    ShapeArena arena_;
+    TrackingResource* memory_{nullptr}; // (owned externally by Engine)
+    std::vector<AnimationClip> clips_;
+    std::deque<Prefab> prefabs_; // stable addresses: levels point at prefabs
+    std::deque<Level> levels_;
+    std::unordered_map<std::string, const Prefab*> prefabIndex_;
+    std::unordered_map<std::string, const Level*> levelIndex_;
+
+    // Variant cache keyed by registered base id; slot None is unused
+    using VariantSet = std::array<const Shape*, ShapeTransformCount>;
+    std::unordered_map<std::string, VariantSet> variants_;
+    std::array<std::array<char, 128>, ShapeTransformCount> glyphMaps_;
+
+    // Hot reload: parsed on the watcher thread, applied by applyReloads()
+    // Only the newest edit of a shape matters, so pending rows are keyed by
+    // id and a burst of saves coalesces into one swap instead of overflowing
+    // a queue; the lock is held just long enough to insert or swap the map
+    std::vector<std::string> shapeDirectories_;
+    std::mutex pendingMutex_;
+    std::unordered_map<std::string, std::vector<std::string>> pendingShapes_;
+    AssetWatcher* watcher_{nullptr}; // (owned externally by Engine)
+    std::vector<int> watchIds_;
+    std::vector<std::unique_ptr<AssetPack>> packs_;
 };
 
 }
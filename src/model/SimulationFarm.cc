@@ -0,0 +1,58 @@
+export module sim.farm;
+
+import <cstdint>;
+import <functional>;
+import <memory>;
+import <vector>;
+
+import controller;
+import engine;
+
+export namespace age {
+
+// Runs one complete headless session (e.g. runSpaceInvaders)
+using SessionFunction = std::function<SessionResult(const SessionOptions& options)>;
+
+// Builds the input source for one instance (nullptr = no input)
+using ControllerFactory = std::function<std::unique_ptr<Controller>(std::uint32_t seed)>;
+
+struct FarmOptions {
+    int instances{1};
+    int threads{0};              // 0 = one per hardware thread
+    std::uint32_t baseSeed{1};   // instance i is seeded from baseSeed and i
+    int maxTicks{3600};          // per instance (0 = until the game ends)
+    ControllerFactory makeController;
+};
+
+// Aggregated results of a farm run
+struct FarmStats {
+    int sessions{0};
+    int wins{0};
+    long long totalTicks{0};
+    long long wallNs{0};
+    double ticksPerSecond{0.0};
+    int minScore{0};
+    int maxScore{0};
+    double meanScore{0.0};
+    std::vector<SessionResult> results; // indexed by instance
+};
+
+// Executes many independent headless sessions across all cores
+// Every instance owns its Engine, World, RNG and input source and there is
+// no global state, so workers share nothing but an atomic index into the
+// instance list; results go to preallocated slots and are aggregated after
+// all threads join. Throughput therefore scales with the number of cores.
+class SimulationFarm {
+public:
+    explicit SimulationFarm(SessionFunction session);
+
+    FarmStats run(const FarmOptions& options);
+
+    // Deterministic per-instance seed (splitmix of baseSeed and index)
+    static std::uint32_t instanceSeed(std::uint32_t baseSeed, int index) noexcept;
+
+private:
+    SessionFunction session_;
+};
+
+}
@@ -0,0 +1,88 @@
+export module world.spatial;
+
+import <cstddef>;
+import <cstdint>;
+import <vector>;
+
+export namespace age {
+
+// Axis-aligned cell range (inclusive world cells)
+struct CellBounds {
+    int minX{0};
+    int minY{0};
+    int maxX{0};
+    int maxY{0};
+};
+
+// Uniform grid of proxies maintained incrementally as objects move
+// Each proxy remembers the grid cells it covers; a move that stays within
+// the same cells costs one comparison, and crossing into new cells only
+// touches the buckets entered and left. Proxy ids are small integers
+// recycled through a free list. Bounds outside the grid are clamped to the
+// edge cells, so objects that leave the world stay queryable.
+class SpatialGrid {
+public:
+    using ProxyId = std::uint32_t;
+    static constexpr ProxyId NoProxy = 0xFFFFFFFFu;
+
+    SpatialGrid(int width, int height, int cellSize = 8);
+
+    ProxyId insert(const CellBounds& bounds, std::uint32_t userData);
+    void move(ProxyId proxy, const CellBounds& bounds);
+    void remove(ProxyId proxy);
+    void clear();
+
+    // Re-bin every proxy (e.g. after tuning the cell size)
+    void setCellSize(int cellSize);
+    void resize(int width, int height);
+
+    // Visit each proxy overlapping bounds exactly once, without allocating
+    // (duplicates across cells are skipped with a per-query stamp)
+    // visit(ProxyId, userData) returns false to stop early
+    template<typename Visitor>
+    void query(const CellBounds& bounds, Visitor&& visit) const;
+
+    // Cell-level access for walkers (raycasts, ring searches)
+    int cellSize() const noexcept;
+    int columns() const noexcept;
+    int rows() const noexcept;
+    int cellX(int x) const noexcept; // clamped to the grid
+    int cellY(int y) const noexcept;
+    const std::vector<ProxyId>& bucket(int cx, int cy) const noexcept;
+
+    const CellBounds& bounds(ProxyId proxy) const noexcept;
+    std::uint32_t userData(ProxyId proxy) const noexcept;
+    std::size_t proxyCount() const noexcept;
+
+    // Query stamps: a walker calls beginVisit() once, then markVisited() per
+    // candidate (true the first time a proxy is seen in this visit)
+    void beginVisit() const noexcept;
+    bool markVisited(ProxyId proxy) const noexcept;
+
+private:
+    struct Proxy {
+        CellBounds bounds;
+        CellBounds cells;
+        std::uint32_t userData;
+        bool live;
+    };
+
+    CellBounds cellRange(const CellBounds& bounds) const noexcept;
+    void link(ProxyId proxy, const CellBounds& cells);
+    void unlink(ProxyId proxy, const CellBounds& cells);
+
+    int width_;
+    int height_;
+    int cellSize_;
+    int columns_;
+    int rows_;
+
+    std::vector<std::vector<ProxyId>> buckets_; // row-major cells
+    std::vector<Proxy> proxies_;
+    std::vector<ProxyId> freeProxies_;
+
+    mutable std::vector<std::uint32_t> visitStamps_; // per proxy
+    mutable std::uint32_t visitStamp_{0};
+};
+
+}
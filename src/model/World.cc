@@ -1,21 +1,60 @@
 export module world;
 
 import <algorithm>;
+import <cstdint>;
+import <functional>;
 import <memory>;
+import <optional>;
 import <string>;
+import <string_view>;
 import <vector>;
 
 import core.hitbox;
 import core.input_event;
+import core.memory;
 import core.position;
+import core.snapshot;
 import entity;
+import nav.flowfield;
 import events.event;
 import events.manager;
 import render.drawable;
+import render.layer;
 import render.shape;
+import render.tilemap;
+import resources.manager;
+import resources.prefab;
+import world.spatial;
 
 export namespace age {
 
+// Called with the id of each entity removeDeadEntities() drops
+using EntityRemovedCallback = std::function<void(int entityId)>;
+
+// Entity filter for spatial queries (defaults match everything)
+struct QueryFilter {
+    std::string_view tag;            // empty = any tag
+    bool solid{true};                // which solidities to include
+    bool trigger{true};
+    bool ghost{true};
+    int excludeId{-1};               // e.g. the querying entity itself
+
+    bool matches(const Entity& entity) const noexcept;
+};
+
+// First entity hit by a raycast
+struct RayHit {
+    Entity* entity;
+    Position cell;   // first cell of the ray inside the entity's hitbox
+    int distance;    // cells stepped from the origin
+};
+
+// Maps a sprite id stored in a snapshot back to a live shape
+using ShapeResolver = std::function<const Shape*(const std::string& spriteId)>;
+
+// Called for each entity rebuilt by restoreSnapshot()
+using EntityRestoredCallback = std::function<void(Entity& entity)>;
+
 class World {
 public:
     enum class BorderMode {
@@ -23,11 +62,52 @@ public:
         View
     };
 
-    World(int width = 78, int height = 20, BorderMode borderMode = BorderMode::Solid);
+    // Entities are allocate_shared through a SharedResourceAllocator on
+    // memory (nullptr = untracked default heap), so each one keeps the
+    // resource alive and may safely outlive the World and Engine; the entity
+    // list's buffer is reported as external bytes when it grows
+    World(int width = 78, int height = 20, BorderMode borderMode = BorderMode::Solid,
+          std::shared_ptr<TrackingResource> memory = nullptr);
 
-    void update(const InputEvent& input);
+    void update(const InputState& input);
 
+    // Broad phase uses the spatial grid; pairs sharing a cell go to the
+    // narrow phase. Entities with continuous collision are binned by the
+    // union of their previous and current hitbox and tested with
+    // Hitbox::sweep(), so the earliest contact along the move is reported
+    // (a Solid mover stops at that contact). Pairs are reported once, in
+    // order of contact time.
     void handleCollisions();
+    void setBroadPhaseCellSize(int cells); // default 8
+
+    // Spatial queries, answered from the incrementally maintained grid
+    // Visitor forms call visit(Entity&) and stop when it returns false; they
+    // never allocate. Collecting forms append to out (reuse it across calls
+    // to avoid allocation) and return the number appended.
+    // Raycast walks grid lines from origin one cell at a time along (dx, dy)
+    // (Bresenham toward origin + (dx, dy) * maxDistance); solid tiles stop the
+    // ray when tilesBlock is set.
+    std::optional<RayHit> raycast(Position origin, int dx, int dy, int maxDistance,
+                                  const QueryFilter& filter = {}, bool tilesBlock = true) const;
+    bool lineOfSight(Position from, Position to, const QueryFilter& blockers = {}, bool tilesBlock = true) const;
+    template<typename Visitor>
+    void visitRay(Position from, Position to, const QueryFilter& filter, Visitor&& visit) const;
+
+    // Entities whose hitbox overlaps the box (world cells, inclusive)
+    template<typename Visitor>
+    void visitBox(const CellBounds& box, const QueryFilter& filter, Visitor&& visit) const;
+    std::size_t queryBox(const CellBounds& box, std::vector<Entity*>& out, const QueryFilter& filter = {}) const;
+
+    // Entities whose hitbox comes within radius cells of center (Chebyshev)
+    template<typename Visitor>
+    void visitRadius(Position center, int radius, const QueryFilter& filter, Visitor&& visit) const;
+    std::size_t queryRadius(Position center, int radius, std::vector<Entity*>& out, const QueryFilter& filter = {}) const;
+
+    // Up to k nearest entities by hitbox distance, closest first; searches
+    // rings of grid cells outward and stops once k are found and no closer
+    // ring remains (maxRadius < 0 = whole world)
+    std::size_t nearest(Position from, std::size_t k, std::vector<Entity*>& out,
+                        const QueryFilter& filter = {}, int maxRadius = -1) const;
 
     void applyBorderRules(Entity& entity);
 
@@ -36,19 +116,72 @@ public:
     std::shared_ptr<Entity> createEntity(int id, const std::string& tag, Position pos, const Shape* shape);
     void removeDeadEntities();
 
+    // Instantiate compiled prefabs (ids are taken from nextId, which advances)
+    // A level's entities are constructed in one preallocated block shared by
+    // aliasing shared_ptrs, so thousands of entities cost a single allocation
+    // plus their movement components. Returns the number spawned.
+    std::shared_ptr<Entity> instantiate(const Prefab& prefab, int id, Position pos);
+    std::size_t instantiateLevel(const Level& level, int& nextId);
+
     // Collect drawables and status lines for rendering
     void collectDrawables(std::vector<Drawable>& out) const;
+    // Interpolated variant for fixed-timestep rendering (alpha in [0, 1])
+    void collectDrawables(std::vector<Drawable>& out, float alpha) const;
     void collectStatusLines(std::vector<std::string>& out) const;
     void clearStatusLines();
     void addStatusLine(const std::string& line);
     void setStatusLines(std::vector<std::string> lines);
 
+    // Static tile layers (scenery without entities), drawn beneath drawables
+    // The World owns each layer; returned references stay valid until clearTileLayers()
+    TileMap& createTileLayer(int widthTiles, int heightTiles, int tileWidth = 1, int tileHeight = 1, int z = -1);
+    void clearTileLayers();
+    void collectRenderLayers(std::vector<const RenderLayer*>& out) const;
+    const std::vector<std::unique_ptr<TileMap>>& tileLayers() const;
+
+    // O(1) per-cell test against the occupancy grids of all tile layers
+    bool isTileSolid(int x, int y) const noexcept;
+    bool overlapsSolidTiles(const Hitbox& hitbox, const Position& pos) const noexcept;
+
+    // Binary snapshot of simulation state: tick count, entities (movement
+    // components, animation state) and the player link. Tile layers and
+    // status lines are level data and are not included.
+    void saveSnapshot(SnapshotWriter& out) const;
+    // Replaces every entity; each distinct sprite id is resolved once through
+    // resolveShape (the ResourceManager when empty). Returns false and leaves
+    // the World untouched if the snapshot is malformed.
+    bool restoreSnapshot(SnapshotReader& in, const ShapeResolver& resolveShape = {});
+    // Re-attach collision callbacks and custom movement components
+    void setOnEntityRestored(EntityRestoredCallback callback);
+
+    // Flow fields for swarms chasing a target around obstacles
+    // Solid tiles are baked in as obstacles (re-baked only when a tile layer's
+    // revision changes). A field can follow an entity; update() then moves its
+    // target every tick, and the field rebuilds only when the target changes
+    // cell, spending at most the per-tick cell budget. Ids are indices and
+    // fields live until clearFlowFields(), which first detaches every
+    // FlowFieldMovement so no follower is left pointing at a freed field.
+    std::uint16_t createFlowField();
+    FlowField* flowField(std::uint16_t id);
+    const FlowField* flowField(std::uint16_t id) const;
+    // Movement component following field id (bound by id and pointer)
+    std::unique_ptr<FlowFieldMovement> followFlowField(std::uint16_t id, float speed) const;
+    void setFlowTarget(std::uint16_t id, Position target);
+    void followEntity(std::uint16_t id, int entityId);
+    void setFlowFieldBudget(int cellsPerTick); // 0 = rebuild fully in one tick
+    void clearFlowFields();
+
     // Getters
     const Hitbox& border() const noexcept;
     BorderMode borderMode() const noexcept;
     int width() const noexcept;
     int height() const noexcept;
     int tickCount() const noexcept;
+    // Narrow-phase tests and colliding pairs from the last handleCollisions()
+    int collisionTestsLastTick() const noexcept;
+    int collisionPairsLastTick() const noexcept;
+    // Hash of simulation state (tick, entity ids/positions/liveness) for replay checks
+    std::uint64_t stateHash() const noexcept;
     const std::vector<std::shared_ptr<Entity>>& entities() const;
     std::shared_ptr<Entity> player() const;
     // Find entity by ID
@@ -58,6 +191,8 @@ public:
 
     // Setters
     void setEventManager(EventManager* events);
+    void setResources(const ResourceManager* resources);
+    void setOnEntityRemoved(EntityRemovedCallback callback);
     void setBorderMode(BorderMode mode);
     void setPlayer(std::shared_ptr<Entity> p);
 
@@ -67,10 +202,50 @@ private:
     int width_;
     int height_;
     int tickCount_{0};
+    int collisionTests_{0};
+    int collisionPairs_{0};
+
+    // Spatial grid shared by the broad phase and queries; every entity owns
+    // a proxy (Entity::spatialProxy()) that update() moves after movement
+    // and removeDeadEntities() releases
+    struct Contact {
+        float time;
+        SpatialGrid::ProxyId a;
+        SpatialGrid::ProxyId b;
+    };
+    CellBounds spatialBounds(const Entity& entity) const noexcept; // swept if enabled
+    void track(Entity& entity);
+    void untrack(Entity& entity);
+    void updateSpatial();
+    SpatialGrid spatial_;
+    std::vector<Entity*> proxyEntities_; // indexed by proxy id
+    std::vector<Contact> contacts_;
     std::vector<std::string> statusLines_;
     std::vector<std::shared_ptr<Entity>> entities_;
+    std::vector<std::unique_ptr<TileMap>> tileLayers_;
     std::shared_ptr<Entity> player_;
     EventManager* events_{nullptr}; // (owned externally by Engine)
+    const ResourceManager* resources_{nullptr}; // (owned externally by Engine)
+    std::shared_ptr<TrackingResource> memory_;  // (shared with every entity)
+    EntityRemovedCallback onEntityRemoved_;
+    EntityRestoredCallback onEntityRestored_;
+
+    // Batched animation pass over every entity with a clip cursor (run in
+    // update() after movement); synchronized frames are computed once per clip
+    void updateAnimations();
+
+    struct FlowFieldSlot {
+        std::unique_ptr<FlowField> field;
+        int followEntityId{-1};
+        std::vector<std::uint32_t> tileRevisions; // per tile layer, at last bake
+    };
+
+    // Re-bake tile obstacles if any layer changed, move followed targets and
+    // advance rebuilds (run in update() after movement)
+    void updateFlowFields();
+    std::vector<FlowFieldSlot> flowFields_;
+    int flowFieldBudget_{0};
+    std::vector<std::int32_t> syncedFrames_; // per clip, -1 = not computed this tick
 };
 
 }
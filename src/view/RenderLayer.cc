@@ -0,0 +1,21 @@
+export module render.layer;
+
+import <string>;
+import <vector>;
+
+export namespace age {
+
+// Abstract layer that the view blits straight into its frame buffer,
+// for content too dense to go through per-object Drawables (tiles, particles)
+class RenderLayer {
+public:
+    virtual ~RenderLayer() = default;
+
+    // Layers interleave with drawables by z (lower is drawn first)
+    virtual int z() const noexcept = 0;
+
+    // Buffer rows are indexed in world cells; anything outside is clipped
+    virtual void renderInto(std::vector<std::string>& buffer) const = 0;
+};
+
+}
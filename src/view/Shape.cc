@@ -1,29 +1,61 @@
 export module render.shape;
 
+import <cstdint>;
 import <iostream>;
 import <string>;
+import <string_view>;
 import <vector>;
 
 export namespace age {
 
+// Sprite pixels stored as one contiguous block with row offsets
+// Row r spans [rowOffsets[r], rowOffsets[r + 1]) of the block, so rows may
+// have different lengths. Standalone shapes own their block; shapes
+// registered with the ResourceManager or loaded from an asset pack view
+// external storage that outlives them.
 class Shape {
 public:
     Shape() = default;
+
+    // Owning shape (rows are flattened into a single allocation)
     Shape(std::string spriteId, std::vector<std::string> pixels);
 
+    // Non-owning shape over a row-major block of width*height chars
+    // (e.g. a mapped asset pack); the block must outlive the shape
+    Shape(std::string spriteId, std::string_view pixels, int width, int height);
+
+    // Non-owning shape over arena storage: height + 1 row offsets into data
+    Shape(std::string spriteId, const char* data, const std::uint32_t* rowOffsets, int height);
+
+    // Copies/moves rebind views of owned storage to the new object
+    Shape(const Shape& other);
+    Shape& operator=(const Shape& other);
+    Shape(Shape&& other) noexcept;
+    Shape& operator=(Shape&& other) noexcept;
+
     const std::string& spriteId() const noexcept;
     int width() const noexcept;
     int height() const noexcept;
 
-    const std::vector<std::string>& rows() const noexcept;
+    std::string_view row(int r) const;
+    bool ownsPixels() const noexcept;
 
     char at(int row, int col) const;
 
 private:
+    void bindOwned() noexcept;
+
     std::string spriteId_;
-    std::vector<std::string> pixels_;
-    int width_;
-    int height_;
+
+    // Owned storage (standalone shapes only)
+    std::string ownedPixels_;
+    std::vector<std::uint32_t> ownedOffsets_;
+
+    // View used for every lookup; rowOffsets_ is null for uniform-width blocks
+    const char* data_{nullptr};
+    const std::uint32_t* rowOffsets_{nullptr};
+    int width_{0};
+    int height_{0};
 };
 
 }
@@ -0,0 +1,105 @@
+export module render.tilemap;
+
+import <array>;
+import <cstdint>;
+import <string>;
+import <vector>;
+
+import core.hitbox;
+import core.position;
+import render.layer;
+import render.shape;
+
+export namespace age {
+
+// Compact index into a TileMap's palette (0 is always the empty tile)
+using TileIndex = std::uint16_t;
+inline constexpr TileIndex EmptyTile = 0;
+
+// Static layer of shapes laid out on a grid, for scenery that never needs
+// to be an Entity (backgrounds, terrain, pipe columns, star fields...)
+// Tiles are stored in fixed-size chunks so empty regions are skipped
+// during rendering, and solid tiles are baked into a per-cell occupancy
+// grid so collision queries are O(1) per cell.
+class TileMap final : public RenderLayer {
+public:
+    // Chunk edge length, in tiles
+    static constexpr int ChunkSize = 16;
+
+    TileMap(int widthTiles, int heightTiles, int tileWidth = 1, int tileHeight = 1, int z = -1);
+
+    // Palette management (shapes are owned by the ResourceManager)
+    // Returns the index to use with setTile()
+    TileIndex registerTile(const Shape* shape, bool solid = false);
+    const Shape* tileShape(TileIndex tile) const noexcept;
+    // Swap the shape behind a palette entry, redrawing every tile that uses
+    // it at once (e.g. twinkling stars); placement, solidity and revision()
+    // are unchanged
+    void setTileShape(TileIndex tile, const Shape* shape);
+    bool isTileSolid(TileIndex tile) const noexcept;
+    std::size_t paletteSize() const noexcept;
+
+    // Tile placement (tile coordinates, out-of-range writes are ignored)
+    void setTile(int tx, int ty, TileIndex tile);
+    TileIndex tileAt(int tx, int ty) const noexcept;
+    void fill(int tx, int ty, int w, int h, TileIndex tile);
+    void clear();
+
+    // Incremented whenever tiles or the origin change (lets dependants such
+    // as flow fields rebuild only when the layer actually changed)
+    std::uint32_t revision() const noexcept;
+
+    // World-space offset of tile (0, 0); moving it scrolls the whole layer
+    void setOrigin(Position origin) noexcept;
+    const Position& origin() const noexcept;
+
+    // Occupancy queries (world cell coordinates)
+    bool isSolidAt(int x, int y) const noexcept;
+    bool overlapsSolid(const Hitbox& hitbox, const Position& pos) const noexcept;
+
+    // Render every non-empty chunk overlapping the buffer straight into it
+    // Spaces in tile shapes are transparent
+    void renderInto(std::vector<std::string>& buffer) const override;
+
+    // Getters
+    int widthTiles() const noexcept;
+    int heightTiles() const noexcept;
+    int tileWidth() const noexcept;
+    int tileHeight() const noexcept;
+    int z() const noexcept override;
+    void setZ(int z) noexcept;
+
+private:
+    struct Chunk {
+        std::array<TileIndex, ChunkSize * ChunkSize> tiles{};
+        int filled{0}; // non-empty tiles, lets rendering skip blank chunks
+    };
+
+    struct PaletteEntry {
+        const Shape* shape;
+        bool solid;
+    };
+
+    Chunk& chunkFor(int tx, int ty);
+    const Chunk* chunkFor(int tx, int ty) const;
+    void rebuildOccupancy(int tx, int ty);
+    void renderChunk(const Chunk& chunk, int cx, int cy, std::vector<std::string>& buffer) const;
+
+    int widthTiles_;
+    int heightTiles_;
+    int tileWidth_;
+    int tileHeight_;
+    int chunksX_;
+    int chunksY_;
+    int z_;
+    Position origin_;
+    std::uint32_t revision_{0};
+
+    std::vector<PaletteEntry> palette_;
+    std::vector<Chunk> chunks_;
+
+    // One byte per covered cell (layer-local), 1 = blocked by a solid tile
+    std::vector<std::uint8_t> occupancy_;
+};
+
+}
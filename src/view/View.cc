@@ -9,7 +9,9 @@ import <vector>;
 import <algorithm>;
 import <clocale>;
 
+import core.memory;
 import render.drawable;
+import render.layer;
 import render.shape;
 
 export namespace age {
@@ -25,6 +27,13 @@ class View {
 public:
     virtual ~View() = default;
     virtual void notify(const std::vector<Drawable>& drawables, const std::vector<std::string>& statusLines) = 0;
+
+    // Render a frame with extra layers (tiles, particles) interleaved by z
+    // Default ignores the layers, so views without layer support still work
+    virtual void notify(const std::vector<const RenderLayer*>& layers, const std::vector<Drawable>& drawables, const std::vector<std::string>& statusLines);
+
+    // Report render buffer memory to resource (default: nothing to report)
+    virtual void setMemoryTracking(TrackingResource* resource);
 };
 
 // Ncurses-based rendering implementation
@@ -34,6 +43,10 @@ public:
     ~CursesView() override;
 
     void notify(const std::vector<Drawable>& drawables, const std::vector<std::string>& statusLines) override;
+    void notify(const std::vector<const RenderLayer*>& layers, const std::vector<Drawable>& drawables, const std::vector<std::string>& statusLines) override;
+
+    // Scratch/previous buffers are reported to resource whenever they resize
+    void setMemoryTracking(TrackingResource* resource) override;
 
 private:
     // Layout constants
@@ -48,6 +61,7 @@ private:
     void ensureBuffers();
     void clearGameBuffer();
     void drawBorder() const;
+    void drawLayer(const RenderLayer& layer);
     void drawDrawable(const Drawable& drawable);
     void drawStatus(const std::vector<std::string>& lines);
     void flushBuffer();
@@ -65,6 +79,8 @@ private:
     // Double-buffering for efficient updates
     std::vector<std::string> prevBuffer_;
     std::vector<std::string> scratchBuffer_;
+    TrackingResource* memory_{nullptr};
+    std::size_t reportedBufferBytes_{0};
 };
 
 }
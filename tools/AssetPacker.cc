@@ -0,0 +1,46 @@
+// Builds a memory-mappable asset pack from shape text files and WAV sounds
+// Usage: asset_packer <out.pack> [shape:<id>=<file.txt>] [sound:<id>=<file.wav>] ...
+
+import <iostream>;
+import <string>;
+
+import resources.pack;
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <out.pack> shape:<id>=<file>|sound:<id>=<file> ...\n";
+        return 1;
+    }
+
+    age::AssetPackWriter writer;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto colon = arg.find(':');
+        auto equals = arg.find('=', colon);
+        if (colon == std::string::npos || equals == std::string::npos) {
+            std::cerr << "bad asset spec: " << arg << '\n';
+            return 1;
+        }
+
+        std::string kind = arg.substr(0, colon);
+        std::string id = arg.substr(colon + 1, equals - colon - 1);
+        std::string path = arg.substr(equals + 1);
+
+        bool ok = false;
+        if (kind == "shape") {
+            ok = writer.addShapeFile(id, path);
+        } else if (kind == "sound") {
+            ok = writer.addWavFile(id, path);
+        }
+        if (!ok) {
+            std::cerr << "failed to add " << arg << '\n';
+            return 1;
+        }
+    }
+
+    if (!writer.write(argv[1])) {
+        std::cerr << "failed to write " << argv[1] << '\n';
+        return 1;
+    }
+    return 0;
+}